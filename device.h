@@ -19,8 +19,11 @@ namespace LoRa
 	{
 	public:
 		virtual void delay(int32_t ms) = 0;
+		/* Milliseconds, same unit as delay() */
 		virtual int32_t timestamp(void) = 0;
 		virtual int64_t timestamp_64(void) = 0;
+		/* Microseconds, override if the platform has a finer clock than milliseconds */
+		virtual int64_t timestamp_us(void) { return timestamp_64() * 1000; }
 
 		virtual ~Device() = default;
 
@@ -14,7 +14,13 @@ namespace LoRa
 	{
 		NO_ERROR = 0,
 		TIMED_OUT,
-		UNSUPPORTED
+		UNSUPPORTED,
+		INVALID_PARAMETER,
+		CRC_ERROR,
+		HEADER_ERROR,
+		AUTHENTICATION_FAILED,
+		REPLAYED,
+		NOT_SYNCHRONIZED
 	};
 }
 
@@ -0,0 +1,368 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "aes.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LORA_AES_X86
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LORA_AES_TARGET
+#else
+#include <cpuid.h>
+#define LORA_AES_TARGET __attribute__((target("aes,sse2")))
+#endif
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#define LORA_AES_ARMV8
+#include <arm_neon.h>
+#endif
+
+using LoRa::AES128;
+using LoRa::AES128_CMAC;
+
+namespace
+{
+	constexpr uint8_t sbox[256] = {
+		0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+		0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+		0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+		0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+		0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+		0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+		0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+		0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+		0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+		0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+		0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+		0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+		0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+		0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+		0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+		0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+	constexpr uint8_t xtime(uint8_t x)
+	{
+		return static_cast<uint8_t>((x << 1) ^ ((x & 0x80) ? 0x1B : 0x00));
+	}
+
+	/* Combined SubBytes + MixColumns table, column bytes are {2s, s, s, 3s} */
+	struct TeTable
+	{
+		uint32_t t[256];
+
+		constexpr TeTable() : t{}
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				const uint8_t s = sbox[i];
+				const uint8_t s2 = xtime(s);
+				const uint8_t s3 = static_cast<uint8_t>(s2 ^ s);
+				t[i] = (static_cast<uint32_t>(s2) << 24) | (static_cast<uint32_t>(s) << 16) | (static_cast<uint32_t>(s) << 8) | s3;
+			}
+		}
+	};
+
+	constexpr TeTable te0{};
+
+	inline uint32_t ror(uint32_t x, unsigned n)
+	{
+		return (x >> n) | (x << (32 - n));
+	}
+
+	inline uint32_t load_be(const uint8_t *p)
+	{
+		return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+	}
+
+	inline void store_be(uint8_t *p, uint32_t v)
+	{
+		p[0] = static_cast<uint8_t>(v >> 24);
+		p[1] = static_cast<uint8_t>(v >> 16);
+		p[2] = static_cast<uint8_t>(v >> 8);
+		p[3] = static_cast<uint8_t>(v);
+	}
+
+#if defined(LORA_AES_X86)
+	bool cpu_has_aes_ni()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 25)) != 0;
+#else
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		{
+			return false;
+		}
+		return (ecx & bit_AES) != 0;
+#endif
+	}
+
+	LORA_AES_TARGET void encrypt_aes_ni(const uint8_t *round_keys, const uint8_t *in, uint8_t *out, size_t n_blocks)
+	{
+		__m128i rk[11];
+		for (int i = 0; i < 11; i++)
+		{
+			rk[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(round_keys + 16 * i));
+		}
+
+		/* Four independent blocks hide the aesenc latency */
+		while (n_blocks >= 4)
+		{
+			__m128i b0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), rk[0]);
+			__m128i b1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16)), rk[0]);
+			__m128i b2 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 32)), rk[0]);
+			__m128i b3 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 48)), rk[0]);
+			for (int i = 1; i < 10; i++)
+			{
+				b0 = _mm_aesenc_si128(b0, rk[i]);
+				b1 = _mm_aesenc_si128(b1, rk[i]);
+				b2 = _mm_aesenc_si128(b2, rk[i]);
+				b3 = _mm_aesenc_si128(b3, rk[i]);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_aesenclast_si128(b0, rk[10]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_aesenclast_si128(b1, rk[10]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out + 32), _mm_aesenclast_si128(b2, rk[10]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out + 48), _mm_aesenclast_si128(b3, rk[10]));
+			in += 64;
+			out += 64;
+			n_blocks -= 4;
+		}
+
+		while (n_blocks--)
+		{
+			__m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), rk[0]);
+			for (int i = 1; i < 10; i++)
+			{
+				b = _mm_aesenc_si128(b, rk[i]);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_aesenclast_si128(b, rk[10]));
+			in += 16;
+			out += 16;
+		}
+	}
+#endif
+
+#if defined(LORA_AES_ARMV8)
+	void encrypt_armv8(const uint8_t *round_keys, const uint8_t *in, uint8_t *out, size_t n_blocks)
+	{
+		uint8x16_t rk[11];
+		for (int i = 0; i < 11; i++)
+		{
+			rk[i] = vld1q_u8(round_keys + 16 * i);
+		}
+
+		while (n_blocks--)
+		{
+			/* vaeseq does AddRoundKey + SubBytes + ShiftRows */
+			uint8x16_t b = vld1q_u8(in);
+			for (int i = 0; i < 9; i++)
+			{
+				b = vaesmcq_u8(vaeseq_u8(b, rk[i]));
+			}
+			b = veorq_u8(vaeseq_u8(b, rk[9]), rk[10]);
+			vst1q_u8(out, b);
+			in += 16;
+			out += 16;
+		}
+	}
+#endif
+}
+
+AES128::AES128(const uint8_t *key, bool use_hardware)
+	: round_keys{}, round_words{}, backend{Backend::PORTABLE}
+{
+	constexpr uint8_t rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+	std::memcpy(round_keys, key, key_size);
+
+	for (uint8_t i = 4; i < 4 * (n_rounds + 1); i++)
+	{
+		uint8_t t[4];
+		std::memcpy(t, &round_keys[4 * (i - 1)], 4);
+
+		if ((i % 4) == 0)
+		{
+			const uint8_t t0 = t[0];
+			t[0] = static_cast<uint8_t>(sbox[t[1]] ^ rcon[(i / 4) - 1]);
+			t[1] = sbox[t[2]];
+			t[2] = sbox[t[3]];
+			t[3] = sbox[t0];
+		}
+
+		for (uint8_t j = 0; j < 4; j++)
+		{
+			round_keys[4 * i + j] = round_keys[4 * (i - 4) + j] ^ t[j];
+		}
+	}
+
+	for (uint8_t i = 0; i < 4 * (n_rounds + 1); i++)
+	{
+		round_words[i] = load_be(&round_keys[4 * i]);
+	}
+
+#if defined(LORA_AES_X86)
+	if (use_hardware && cpu_has_aes_ni())
+	{
+		backend = Backend::AES_NI;
+	}
+#elif defined(LORA_AES_ARMV8)
+	if (use_hardware)
+	{
+		backend = Backend::ARMV8;
+	}
+#else
+	(void)use_hardware;
+#endif
+}
+
+void LoRa::AES128::encrypt_block(const uint8_t *in, uint8_t *out) const
+{
+	encrypt_blocks(in, out, 1);
+}
+
+void LoRa::AES128::encrypt_blocks(const uint8_t *in, uint8_t *out, size_t n_blocks) const
+{
+#if defined(LORA_AES_X86)
+	if (backend == Backend::AES_NI)
+	{
+		encrypt_aes_ni(round_keys, in, out, n_blocks);
+		return;
+	}
+#elif defined(LORA_AES_ARMV8)
+	if (backend == Backend::ARMV8)
+	{
+		encrypt_armv8(round_keys, in, out, n_blocks);
+		return;
+	}
+#endif
+
+	while (n_blocks--)
+	{
+		encrypt_portable(in, out);
+		in += block_size;
+		out += block_size;
+	}
+}
+
+void LoRa::AES128::encrypt_portable(const uint8_t *in, uint8_t *out) const
+{
+	const uint32_t *rk = round_words;
+	const uint32_t *te = te0.t;
+
+	uint32_t s0 = load_be(in) ^ rk[0];
+	uint32_t s1 = load_be(in + 4) ^ rk[1];
+	uint32_t s2 = load_be(in + 8) ^ rk[2];
+	uint32_t s3 = load_be(in + 12) ^ rk[3];
+
+	for (uint8_t round = 1; round < n_rounds; round++)
+	{
+		rk += 4;
+		const uint32_t t0 = te[s0 >> 24] ^ ror(te[(s1 >> 16) & 0xFF], 8) ^ ror(te[(s2 >> 8) & 0xFF], 16) ^ ror(te[s3 & 0xFF], 24) ^ rk[0];
+		const uint32_t t1 = te[s1 >> 24] ^ ror(te[(s2 >> 16) & 0xFF], 8) ^ ror(te[(s3 >> 8) & 0xFF], 16) ^ ror(te[s0 & 0xFF], 24) ^ rk[1];
+		const uint32_t t2 = te[s2 >> 24] ^ ror(te[(s3 >> 16) & 0xFF], 8) ^ ror(te[(s0 >> 8) & 0xFF], 16) ^ ror(te[s1 & 0xFF], 24) ^ rk[2];
+		const uint32_t t3 = te[s3 >> 24] ^ ror(te[(s0 >> 16) & 0xFF], 8) ^ ror(te[(s1 >> 8) & 0xFF], 16) ^ ror(te[s2 & 0xFF], 24) ^ rk[3];
+		s0 = t0;
+		s1 = t1;
+		s2 = t2;
+		s3 = t3;
+	}
+
+	rk += 4;
+
+	/* Last round has no MixColumns */
+	auto last = [](uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k) -> uint32_t
+	{
+		return ((static_cast<uint32_t>(sbox[a >> 24]) << 24) |
+				(static_cast<uint32_t>(sbox[(b >> 16) & 0xFF]) << 16) |
+				(static_cast<uint32_t>(sbox[(c >> 8) & 0xFF]) << 8) |
+				static_cast<uint32_t>(sbox[d & 0xFF])) ^
+			   k;
+	};
+
+	store_be(out, last(s0, s1, s2, s3, rk[0]));
+	store_be(out + 4, last(s1, s2, s3, s0, rk[1]));
+	store_be(out + 8, last(s2, s3, s0, s1, rk[2]));
+	store_be(out + 12, last(s3, s0, s1, s2, rk[3]));
+}
+
+AES128_CMAC::AES128_CMAC(const AES128 &aes)
+	: aes{aes}, k1{}, k2{}
+{
+	uint8_t l[AES128::block_size] = {};
+	aes.encrypt_block(l, l);
+
+	/* K1 = L << 1, K2 = K1 << 1, both xor Rb when the shifted out bit is set */
+	for (uint8_t i = 0; i < AES128::block_size; i++)
+	{
+		k1[i] = static_cast<uint8_t>((l[i] << 1) | ((i + 1 < AES128::block_size) ? (l[i + 1] >> 7) : 0));
+	}
+	if (l[0] & 0x80)
+	{
+		k1[AES128::block_size - 1] ^= 0x87;
+	}
+
+	for (uint8_t i = 0; i < AES128::block_size; i++)
+	{
+		k2[i] = static_cast<uint8_t>((k1[i] << 1) | ((i + 1 < AES128::block_size) ? (k1[i + 1] >> 7) : 0));
+	}
+	if (k1[0] & 0x80)
+	{
+		k2[AES128::block_size - 1] ^= 0x87;
+	}
+}
+
+void LoRa::AES128_CMAC::compute(const Segment *segments, uint8_t count, uint8_t *mac) const
+{
+	uint8_t x[AES128::block_size] = {};
+	uint8_t block[AES128::block_size];
+	uint8_t fill = 0;
+
+	for (uint8_t s = 0; s < count; s++)
+	{
+		for (uint8_t i = 0; i < segments[s].size; i++)
+		{
+			/* A full block is only processed once more data follows, the last block is special */
+			if (fill == AES128::block_size)
+			{
+				for (uint8_t j = 0; j < AES128::block_size; j++)
+				{
+					x[j] ^= block[j];
+				}
+				aes.encrypt_block(x, x);
+				fill = 0;
+			}
+			block[fill++] = segments[s].data[i];
+		}
+	}
+
+	if (fill == AES128::block_size)
+	{
+		for (uint8_t j = 0; j < AES128::block_size; j++)
+		{
+			x[j] ^= block[j] ^ k1[j];
+		}
+	}
+	else
+	{
+		block[fill++] = 0x80;
+		while (fill < AES128::block_size)
+		{
+			block[fill++] = 0x00;
+		}
+		for (uint8_t j = 0; j < AES128::block_size; j++)
+		{
+			x[j] ^= block[j] ^ k2[j];
+		}
+	}
+
+	aes.encrypt_block(x, mac);
+}
@@ -0,0 +1,75 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * AES-128 block encryption and CMAC. Uses AES-NI or ARMv8 crypto extensions when
+ * available and falls back to a portable table based implementation.
+ */
+
+#ifndef __LORA_AES_H__
+#define __LORA_AES_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	class AES128
+	{
+	public:
+		static constexpr uint8_t block_size = 16;
+		static constexpr uint8_t key_size = 16;
+
+		enum class Backend : uint8_t
+		{
+			PORTABLE = 0,
+			AES_NI = 1,
+			ARMV8 = 2
+
+		};
+
+		/**
+		 * @param use_hardware false forces the portable backend, e.g. to compare backends.
+		 */
+		explicit AES128(const uint8_t *key, bool use_hardware = true);
+
+		void encrypt_block(const uint8_t *in, uint8_t *out) const;
+		/**
+		 * @brief Encrypts n consecutive blocks, in and out may be the same buffer.
+		 * Hardware backends keep several blocks in flight.
+		 */
+		void encrypt_blocks(const uint8_t *in, uint8_t *out, size_t n_blocks) const;
+
+		inline Backend get_backend() const { return backend; }
+
+	private:
+		static constexpr uint8_t n_rounds = 10;
+
+		void encrypt_portable(const uint8_t *in, uint8_t *out) const;
+
+		alignas(16) uint8_t round_keys[(n_rounds + 1) * block_size]; /* FIPS-197 byte order */
+		uint32_t round_words[(n_rounds + 1) * 4];					 /* Same keys as big endian words */
+		Backend backend;
+	};
+
+	/**
+	 * @brief AES-CMAC as in RFC 4493, computed over a list of segments.
+	 */
+	class AES128_CMAC
+	{
+	public:
+		explicit AES128_CMAC(const AES128 &aes);
+
+		void compute(const Segment *segments, uint8_t count, uint8_t *mac) const;
+
+	private:
+		const AES128 &aes;
+		uint8_t k1[AES128::block_size];
+		uint8_t k2[AES128::block_size];
+	};
+}
+
+#endif // __LORA_AES_H__
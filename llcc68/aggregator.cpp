@@ -0,0 +1,117 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "aggregator.h"
+#include <cstring>
+
+using LoRa::Frame_Aggregator;
+using LoRa::Frame_Deaggregator;
+
+Frame_Aggregator::Frame_Aggregator(LLCC68 &radio, int64_t max_hold_ms, uint8_t frame_size)
+	: radio{radio}, max_hold_ms{max_hold_ms}, frame_size{frame_size}, frame{}, used{0}, n_pending{0}, first_at{0}, pending_airtime{0}, stats{}
+{
+}
+
+bool LoRa::Frame_Aggregator::add(const uint8_t *message, uint8_t size)
+{
+	const uint16_t record_size = static_cast<uint16_t>(size) + 1;
+
+	if ((size == 0) || (record_size > frame_size))
+	{
+		return false;
+	}
+
+	if (used + record_size > frame_size)
+	{
+		flush();
+	}
+
+	if (n_pending == 0)
+	{
+		first_at = radio.get_device().timestamp_64();
+	}
+
+	frame[used] = size;
+	std::memcpy(&frame[used + 1], message, size);
+	used += static_cast<uint8_t>(record_size);
+	n_pending++;
+	pending_airtime += radio.get_time_on_air(size);
+
+	if (used == frame_size)
+	{
+		flush();
+	}
+
+	return true;
+}
+
+bool LoRa::Frame_Aggregator::poll()
+{
+	if ((n_pending == 0) || ((radio.get_device().timestamp_64() - first_at) < max_hold_ms))
+	{
+		return false;
+	}
+
+	flush();
+	return true;
+}
+
+void LoRa::Frame_Aggregator::flush()
+{
+	if (n_pending == 0)
+	{
+		return;
+	}
+
+	radio.send_packet(frame, used);
+
+	stats.frames++;
+	stats.messages += n_pending;
+	stats.airtime_single += pending_airtime;
+	stats.airtime_aggregated += radio.get_time_on_air(used);
+
+	used = 0;
+	n_pending = 0;
+	pending_airtime = 0;
+}
+
+uint32_t LoRa::Frame_Aggregator::get_airtime_saved_per_message() const
+{
+	if ((stats.messages == 0) || (stats.airtime_aggregated >= stats.airtime_single))
+	{
+		return 0;
+	}
+
+	return static_cast<uint32_t>((stats.airtime_single - stats.airtime_aggregated) / stats.messages);
+}
+
+Frame_Deaggregator::Frame_Deaggregator(const uint8_t *frame, uint8_t size)
+	: frame{frame}, size{size}, position{0}, valid{true}
+{
+}
+
+bool LoRa::Frame_Deaggregator::next(const uint8_t **message, uint8_t *size)
+{
+	if (!valid || (position >= this->size))
+	{
+		return false;
+	}
+
+	const uint8_t length = frame[position];
+
+	if ((length == 0) || (static_cast<uint16_t>(position) + 1 + length > this->size))
+	{
+		valid = false;
+		return false;
+	}
+
+	*message = &frame[position + 1];
+	*size = length;
+	position += length + 1;
+
+	return true;
+}
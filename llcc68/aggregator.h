@@ -0,0 +1,97 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Packs several small messages into one LoRa frame and unpacks them on the receive side.
+ * Frame layout: [length][message] repeated until the end of the frame.
+ */
+
+#ifndef __LLCC68_AGGREGATOR_H__
+#define __LLCC68_AGGREGATOR_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	class Frame_Aggregator
+	{
+	public:
+		static constexpr uint8_t max_frame_size = 255;
+
+		typedef struct
+		{
+			uint32_t frames;
+			uint32_t messages;
+			uint64_t airtime_single;	 /* us, had every message been sent on its own */
+			uint64_t airtime_aggregated; /* us, actually used */
+
+		} Stats;
+
+		/**
+		 * @param max_hold_ms Maximum time the first message of a frame waits for company.
+		 * @param frame_size Frames are sent once this size would be exceeded.
+		 */
+		Frame_Aggregator(LLCC68 &radio, int64_t max_hold_ms, uint8_t frame_size = max_frame_size);
+
+		/**
+		 * @brief Adds a message to the pending frame, sending the frame first if the message doesn't fit.
+		 * @return false if the message can never fit in a frame.
+		 */
+		bool add(const uint8_t *message, uint8_t size);
+		/**
+		 * @brief Sends the pending frame once its hold time has expired. Call periodically.
+		 * @return true if a frame was sent.
+		 */
+		bool poll();
+		/**
+		 * @brief Sends the pending frame right away.
+		 */
+		void flush();
+
+		inline const Stats &get_stats() const { return stats; }
+		/* Average airtime saved per message, in microseconds */
+		uint32_t get_airtime_saved_per_message() const;
+		inline uint8_t get_pending_messages() const { return n_pending; }
+
+	private:
+		LLCC68 &radio;
+		int64_t max_hold_ms;
+		uint8_t frame_size;
+
+		uint8_t frame[max_frame_size];
+		uint8_t used;
+		uint8_t n_pending;
+		int64_t first_at;		  /* ms, when the first pending message was added */
+		uint64_t pending_airtime; /* us, single airtime of the pending messages */
+		Stats stats;
+	};
+
+	/**
+	 * @brief Iterates over the messages of a received aggregate frame. Messages are not copied.
+	 */
+	class Frame_Deaggregator
+	{
+	public:
+		Frame_Deaggregator(const uint8_t *frame, uint8_t size);
+
+		/**
+		 * @param message Set to the start of the next message within the frame.
+		 * @param size Set to the size of the next message.
+		 * @return false at the end of the frame, or if the frame is malformed.
+		 */
+		bool next(const uint8_t **message, uint8_t *size);
+		/* false if a length field pointed past the end of the frame */
+		inline bool is_valid() const { return valid; }
+
+	private:
+		const uint8_t *frame;
+		uint8_t size;
+		uint8_t position;
+		bool valid;
+	};
+}
+
+#endif // __LLCC68_AGGREGATOR_H__
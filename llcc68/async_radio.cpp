@@ -0,0 +1,311 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "async_radio.h"
+
+using LoRa::Async_Radio;
+using LoRa::Radio_Task;
+
+LoRa::Radio_Task &LoRa::Radio_Task::operator=(Radio_Task &&other) noexcept
+{
+	if (this != &other)
+	{
+		if (handle)
+		{
+			handle.destroy();
+		}
+		handle = other.handle;
+		other.handle = nullptr;
+	}
+
+	return *this;
+}
+
+Radio_Task::~Radio_Task()
+{
+	if (handle)
+	{
+		handle.destroy();
+	}
+}
+
+bool LoRa::Async_Radio::Operation::await_suspend(std::coroutine_handle<> waiter)
+{
+	this->waiter = waiter;
+
+	/* Resume right away if it couldn't be queued */
+	return owner.submit(this);
+}
+
+Async_Radio::Async_Radio(LLCC68 &radio)
+	: radio{radio}, sessions{}, n_sessions{0}, ready{}, ready_head{0}, ready_count{0},
+	  pending{}, pending_head{0}, pending_count{0}, sleepers{}, n_sleepers{0}, active{nullptr}, idle{true}
+{
+}
+
+Async_Radio::~Async_Radio()
+{
+	if (active != nullptr)
+	{
+		radio.cancel();
+	}
+
+	/* Frames of awaited sub-sessions are owned by their parents */
+	for (uint8_t i = 0; i < max_sessions; i++)
+	{
+		if (sessions[i])
+		{
+			sessions[i].destroy();
+		}
+	}
+}
+
+bool LoRa::Async_Radio::spawn(Radio_Task task)
+{
+	if (!task.handle || (n_sessions == max_sessions))
+	{
+		return false;
+	}
+
+	for (uint8_t i = 0; i < max_sessions; i++)
+	{
+		if (!sessions[i])
+		{
+			sessions[i] = task.handle;
+			task.handle = nullptr;
+			n_sessions++;
+			make_ready(sessions[i]);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+LoRa::Async_Radio::Send_Operation LoRa::Async_Radio::send(const uint8_t *packet, uint8_t size)
+{
+	Send_Operation operation{*this, Operation::Kind::SEND};
+	operation.single = Segment{packet, size};
+	operation.size = size;
+
+	return operation;
+}
+
+LoRa::Async_Radio::Send_Operation LoRa::Async_Radio::send(const Segment *segments, uint8_t count)
+{
+	Send_Operation operation{*this, Operation::Kind::SEND};
+	uint16_t size = 0;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		size += segments[i].size;
+	}
+
+	operation.segments = segments;
+	operation.count = count;
+	operation.size = (size > 255) ? 255 : static_cast<uint8_t>(size); /* start_transmit rejects it */
+
+	return operation;
+}
+
+LoRa::Async_Radio::Receive_Operation LoRa::Async_Radio::receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms)
+{
+	Receive_Operation operation{*this, Operation::Kind::RECEIVE};
+	operation.buffer = buffer;
+	operation.max_size = max_size;
+	operation.timeout_ms = timeout_ms;
+
+	return operation;
+}
+
+LoRa::Async_Radio::Cad_Operation LoRa::Async_Radio::cad(LLCC68_Constants::CadSymbolNum symbolNum)
+{
+	Cad_Operation operation{*this, Operation::Kind::CAD};
+	operation.cad_symbols = symbolNum;
+
+	return operation;
+}
+
+LoRa::Async_Radio::Sleep_Operation LoRa::Async_Radio::sleep_for(uint32_t ms)
+{
+	Sleep_Operation operation{*this, Operation::Kind::SLEEP};
+	operation.timeout_ms = ms;
+
+	return operation;
+}
+
+bool LoRa::Async_Radio::submit(Operation *operation)
+{
+	if (operation->kind == Operation::Kind::SLEEP)
+	{
+		if (n_sleepers == max_sessions)
+		{
+			operation->error = ErrorCode::INVALID_PARAMETER;
+			return false;
+		}
+		operation->deadline = radio.get_device().timestamp_64() + operation->timeout_ms;
+		sleepers[n_sleepers++] = operation;
+		return true;
+	}
+
+	if (pending_count == max_sessions)
+	{
+		operation->error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	pending[(pending_head + pending_count) % max_sessions] = operation;
+	pending_count++;
+
+	return true;
+}
+
+bool LoRa::Async_Radio::poll()
+{
+	const int64_t now = radio.get_device().timestamp_64();
+
+	idle = true;
+
+	if (active != nullptr)
+	{
+		if (radio.is_irq_pending())
+		{
+			complete(active);
+		}
+		else if (now >= active->deadline)
+		{
+			radio.cancel();
+			active->error = ErrorCode::TIMED_OUT;
+			make_ready(active->waiter);
+			active = nullptr;
+		}
+	}
+
+	if (active == nullptr)
+	{
+		start_next(now);
+	}
+
+	for (uint8_t i = 0; i < n_sleepers;)
+	{
+		if (now >= sleepers[i]->deadline)
+		{
+			make_ready(sleepers[i]->waiter);
+			sleepers[i] = sleepers[--n_sleepers];
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	/* Sessions made ready while resuming wait for the next poll */
+	for (uint8_t n = ready_count; n > 0; n--)
+	{
+		const std::coroutine_handle<> handle = ready[ready_head];
+		ready_head = (ready_head + 1) % max_sessions;
+		ready_count--;
+		idle = false;
+		handle.resume();
+	}
+
+	for (uint8_t i = 0; i < max_sessions; i++)
+	{
+		if (sessions[i] && sessions[i].done())
+		{
+			sessions[i].destroy();
+			sessions[i] = nullptr;
+			n_sessions--;
+		}
+	}
+
+	return n_sessions != 0;
+}
+
+void LoRa::Async_Radio::run()
+{
+	while (poll())
+	{
+		if (idle && (ready_count == 0))
+		{
+			radio.get_device().delay(1);
+		}
+	}
+}
+
+void LoRa::Async_Radio::start_next(int64_t now)
+{
+	while ((active == nullptr) && (pending_count != 0))
+	{
+		Operation *operation = pending[pending_head];
+		pending_head = (pending_head + 1) % max_sessions;
+		pending_count--;
+
+		bool started = false;
+
+		switch (operation->kind)
+		{
+		case Operation::Kind::SEND:
+			started = radio.start_transmit((operation->segments != nullptr) ? operation->segments : &operation->single, operation->count);
+			operation->deadline = now + radio.get_time_on_air(operation->size) / 1000 + tx_guard_ms;
+			break;
+		case Operation::Kind::RECEIVE:
+			started = radio.start_receive(operation->timeout_ms);
+			operation->deadline = now + operation->timeout_ms + radio.get_time_on_air(255) / 1000 + rx_guard_ms;
+			break;
+		case Operation::Kind::CAD:
+			started = radio.start_cad(operation->cad_symbols);
+			operation->deadline = now + cad_guard_ms;
+			break;
+		default:
+			break;
+		}
+
+		idle = false;
+
+		if (started)
+		{
+			active = operation;
+		}
+		else
+		{
+			operation->error = radio.get_last_error();
+			make_ready(operation->waiter);
+		}
+	}
+}
+
+void LoRa::Async_Radio::complete(Operation *operation)
+{
+	switch (operation->kind)
+	{
+	case Operation::Kind::SEND:
+		radio.finish_transmit();
+		break;
+	case Operation::Kind::RECEIVE:
+		operation->size = radio.finish_receive(operation->buffer, operation->max_size);
+		break;
+	case Operation::Kind::CAD:
+		operation->detected = radio.finish_cad();
+		break;
+	default:
+		break;
+	}
+
+	/* Reset by every start_*() call */
+	operation->error = radio.get_last_error();
+
+	active = nullptr;
+	idle = false;
+	make_ready(operation->waiter);
+}
+
+void LoRa::Async_Radio::make_ready(std::coroutine_handle<> handle)
+{
+	ready[(ready_head + ready_count) % max_sessions] = handle;
+	ready_count++;
+}
@@ -0,0 +1,251 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Coroutine interface for radio operations, requires C++20.
+ *
+ *	Radio_Task ping(Async_Radio &radio)
+ *	{
+ *		uint8_t buffer[32] = {'p', 'i', 'n', 'g'};
+ *		co_await radio.send(buffer, 4);
+ *		auto reply = co_await radio.receive(buffer, sizeof(buffer), 1000);
+ *	}
+ *
+ *	radio.spawn(ping(radio));
+ *	radio.run();
+ */
+
+#ifndef __LLCC68_ASYNC_RADIO_H__
+#define __LLCC68_ASYNC_RADIO_H__
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	class Async_Radio;
+
+	/**
+	 * @brief Coroutine type of radio sessions. Starts suspended, hand it to Async_Radio::spawn()
+	 * or co_await it from another session to run it to completion.
+	 */
+	class Radio_Task
+	{
+	public:
+		struct promise_type
+		{
+			struct Final_Awaiter
+			{
+				bool await_ready() noexcept { return false; }
+				/* Continue the awaiting session, if any */
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+				{
+					const auto continuation = handle.promise().continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+				void await_resume() noexcept {}
+			};
+
+			Radio_Task get_return_object() { return Radio_Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			Final_Awaiter final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+
+			std::coroutine_handle<> continuation;
+		};
+
+		typedef std::coroutine_handle<promise_type> Handle;
+
+		Radio_Task(Radio_Task &&other) noexcept : handle{other.handle} { other.handle = nullptr; }
+		Radio_Task &operator=(Radio_Task &&other) noexcept;
+
+		Radio_Task(const Radio_Task &) = delete;
+		Radio_Task &operator=(const Radio_Task &) = delete;
+
+		~Radio_Task();
+
+		bool await_ready() const noexcept { return !handle || handle.done(); }
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+		{
+			handle.promise().continuation = caller;
+			return handle;
+		}
+		void await_resume() noexcept {}
+
+	private:
+		friend class Async_Radio;
+
+		explicit Radio_Task(Handle handle) : handle{handle} {}
+
+		Handle handle;
+	};
+
+	/**
+	 * @brief Single-threaded scheduler running many sessions on one radio.
+	 * Sessions suspend on radio operations and are resumed once DIO1 reports completion,
+	 * operations from different sessions are carried out one after another in request order.
+	 */
+	class Async_Radio
+	{
+	public:
+		static constexpr uint8_t max_sessions = 16;
+
+		typedef struct
+		{
+			uint8_t size; /* 0 on timeout or error */
+			ErrorCode error;
+
+		} RxResult;
+
+		/* Awaitable radio operation, returned by send(), receive(), cad() and sleep_for() */
+		class Operation
+		{
+		public:
+			bool await_ready() const noexcept { return false; }
+			bool await_suspend(std::coroutine_handle<> waiter);
+
+		protected:
+			friend class Async_Radio;
+
+			enum class Kind : uint8_t
+			{
+				SEND,
+				RECEIVE,
+				CAD,
+				SLEEP
+
+			};
+
+			Operation(Async_Radio &owner, Kind kind) : owner{owner}, kind{kind} {}
+
+			Async_Radio &owner;
+			Kind kind;
+			Segment single{};					 /* Used when segments is null */
+			const Segment *segments = nullptr;
+			uint8_t count = 1;
+			uint8_t *buffer = nullptr;
+			uint8_t max_size = 0;
+			uint32_t timeout_ms = 0;
+			LLCC68_Constants::CadSymbolNum cad_symbols = LLCC68_Constants::CadSymbolNum::CAD_ON_2_SYMB;
+			int64_t deadline = 0;
+			std::coroutine_handle<> waiter;
+
+			uint8_t size = 0;
+			bool detected = false;
+			ErrorCode error = ErrorCode::NO_ERROR;
+		};
+
+		class Send_Operation : public Operation
+		{
+		public:
+			ErrorCode await_resume() const noexcept { return error; }
+
+		private:
+			friend class Async_Radio;
+			using Operation::Operation;
+		};
+
+		class Receive_Operation : public Operation
+		{
+		public:
+			RxResult await_resume() const noexcept { return RxResult{size, error}; }
+
+		private:
+			friend class Async_Radio;
+			using Operation::Operation;
+		};
+
+		class Cad_Operation : public Operation
+		{
+		public:
+			/* true if LoRa activity was detected */
+			bool await_resume() const noexcept { return detected; }
+
+		private:
+			friend class Async_Radio;
+			using Operation::Operation;
+		};
+
+		class Sleep_Operation : public Operation
+		{
+		public:
+			void await_resume() const noexcept {}
+
+		private:
+			friend class Async_Radio;
+			using Operation::Operation;
+		};
+
+		explicit Async_Radio(LLCC68 &radio);
+		/* Unfinished sessions are destroyed */
+		~Async_Radio();
+
+		Async_Radio(const Async_Radio &) = delete;
+		Async_Radio &operator=(const Async_Radio &) = delete;
+
+		/**
+		 * @brief Adds a session, it starts running on the next poll().
+		 * @return false if max_sessions are already running.
+		 */
+		bool spawn(Radio_Task task);
+		/**
+		 * @brief Completes finished radio operations, starts the next one and resumes ready sessions.
+		 * Never blocks, call it from an event loop or DIO1 interrupt handler context.
+		 * @return false once every session has finished.
+		 */
+		bool poll();
+		/**
+		 * @brief Polls until every session has finished. Waits 1ms between polls only when nothing is ready.
+		 */
+		void run();
+
+		/**
+		 * @brief Sends a packet. Packet must stay valid until the operation completes,
+		 * e.g. keep it in the session's frame.
+		 */
+		Send_Operation send(const uint8_t *packet, uint8_t size);
+		/* Scatter-gather version, the segments array must also stay valid */
+		Send_Operation send(const Segment *segments, uint8_t count);
+		/* Single RX, see LLCC68::receive_packet */
+		Receive_Operation receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms);
+		/* Channel activity detection, LoRa only */
+		Cad_Operation cad(LLCC68_Constants::CadSymbolNum symbolNum = LLCC68_Constants::CadSymbolNum::CAD_ON_2_SYMB);
+		/* Suspends the session without occupying the radio */
+		Sleep_Operation sleep_for(uint32_t ms);
+
+		inline LLCC68 &get_radio() const { return radio; }
+		inline uint8_t get_session_count() const { return n_sessions; }
+
+	private:
+		/* Host side limits, in case DIO1 is never raised */
+		static constexpr int64_t tx_guard_ms = 100;
+		static constexpr int64_t rx_guard_ms = 10;
+		static constexpr int64_t cad_guard_ms = 500;
+
+		bool submit(Operation *operation);
+		void start_next(int64_t now);
+		void complete(Operation *operation);
+		void make_ready(std::coroutine_handle<> handle);
+
+		LLCC68 &radio;
+		Radio_Task::Handle sessions[max_sessions];
+		uint8_t n_sessions;
+		std::coroutine_handle<> ready[max_sessions];
+		uint8_t ready_head;
+		uint8_t ready_count;
+		Operation *pending[max_sessions]; /* Radio operations waiting for the radio, FIFO */
+		uint8_t pending_head;
+		uint8_t pending_count;
+		Operation *sleepers[max_sessions];
+		uint8_t n_sleepers;
+		Operation *active; /* Operation running on the radio */
+		bool idle;		   /* Last poll did nothing */
+	};
+}
+
+#endif // __LLCC68_ASYNC_RADIO_H__
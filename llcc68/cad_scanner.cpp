@@ -0,0 +1,179 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "cad_scanner.h"
+
+using LoRa::CAD_Scanner;
+
+CAD_Scanner::CAD_Scanner(LLCC68 &radio)
+	: radio{radio}, targets{}, traffic_q8{}, credit{}, n_targets{0}, adaptive{true}, stats{}, last_error{ErrorCode::NO_ERROR}
+{
+}
+
+bool LoRa::CAD_Scanner::add_target(uint32_t frequency, LLCC68_Constants::SF sf)
+{
+	LLCC68_config config = radio.get_config();
+
+	config.rf_freq = frequency;
+	config.modulation_params._lora.lora_sf = sf;
+
+	if ((n_targets == max_targets) || (config.modulation_params._lora.bandwidth != LLCC68_Constants::BW::LORA_BW_125) ||
+		!LLCC68::is_valid_config(config))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	targets[n_targets] = Target{frequency, sf};
+	traffic_q8[n_targets] = 0;
+	credit[n_targets] = 0;
+	n_targets++;
+
+	return true;
+}
+
+uint8_t LoRa::CAD_Scanner::receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint8_t *target)
+{
+	if ((n_targets == 0) || (radio.get_packet_type() != LLCC68_Constants::PacketType::LORA))
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return 0;
+	}
+
+	Device &device = radio.get_device();
+	const int64_t deadline = device.timestamp_64() + timeout_ms;
+
+	while (device.timestamp_64() < deadline)
+	{
+		const uint8_t i = next_target();
+		bool detected = false;
+
+		if (!tune(i) || !run_cad(i, &detected))
+		{
+			return 0;
+		}
+		if (!detected)
+		{
+			continue;
+		}
+
+		/* Catch the rest of the preamble and the header, receive_packet extends the window for the payload */
+		const auto &lora = radio.get_config();
+		const uint32_t symbol_us = LLCC68::calculate_symbol_time(targets[i].sf, lora.modulation_params._lora.bandwidth);
+		const uint32_t window_ms = (symbol_us * (lora.packet_params._lora.preambleLength + 13)) / 1000 + 1;
+		const uint8_t size = radio.receive_packet(buffer, max_size, window_ms);
+
+		if (size == 0)
+		{
+			stats.false_detections++;
+			continue;
+		}
+
+		record_frame(i);
+		if (target != nullptr)
+		{
+			*target = i;
+		}
+		last_error = ErrorCode::NO_ERROR;
+
+		return size;
+	}
+
+	last_error = ErrorCode::TIMED_OUT;
+	return 0;
+}
+
+uint8_t LoRa::CAD_Scanner::next_target()
+{
+	int32_t total = 0;
+	uint8_t best = 0;
+
+	for (uint8_t i = 0; i < n_targets; i++)
+	{
+		const int32_t weight = min_weight + (adaptive ? traffic_q8[i] : 0);
+
+		credit[i] += weight;
+		total += weight;
+		if (credit[i] > credit[best])
+		{
+			best = i;
+		}
+	}
+
+	credit[best] -= total;
+
+	return best;
+}
+
+bool LoRa::CAD_Scanner::tune(uint8_t i)
+{
+	const LLCC68_config &active = radio.get_config();
+
+	if ((active.rf_freq == targets[i].frequency) && (active.modulation_params._lora.lora_sf == targets[i].sf))
+	{
+		return true;
+	}
+
+	/* apply_config only sends what differs, i.e. frequency and/or modulation params */
+	LLCC68_config config = active;
+	config.rf_freq = targets[i].frequency;
+	config.modulation_params._lora.lora_sf = targets[i].sf;
+
+	if (!radio.apply_config(config))
+	{
+		last_error = radio.get_last_error();
+		return false;
+	}
+
+	return true;
+}
+
+bool LoRa::CAD_Scanner::run_cad(uint8_t i, bool *detected)
+{
+	Device &device = radio.get_device();
+	const uint32_t symbol_us = LLCC68::calculate_symbol_time(targets[i].sf, radio.get_config().modulation_params._lora.bandwidth);
+	/* CAD on 2 symbols plus processing, with margin */
+	const int64_t guard = device.timestamp_64() + (4 * symbol_us) / 1000 + 10;
+
+	if (!radio.start_cad())
+	{
+		last_error = radio.get_last_error();
+		return false;
+	}
+	stats.cads++;
+
+	while (!radio.is_irq_pending())
+	{
+		if (device.timestamp_64() > guard)
+		{
+			radio.cancel();
+			last_error = ErrorCode::TIMED_OUT;
+			return false;
+		}
+		device.delay(1);
+	}
+
+	*detected = radio.finish_cad();
+	if (*detected)
+	{
+		stats.detections++;
+	}
+
+	return true;
+}
+
+void LoRa::CAD_Scanner::record_frame(uint8_t i)
+{
+	/* EWMA with gain 1/8, converges to 256 times the pair's share of the frames */
+	for (uint8_t k = 0; k < n_targets; k++)
+	{
+		traffic_q8[k] = static_cast<uint16_t>(traffic_q8[k] - (traffic_q8[k] >> 3) + ((k == i) ? 32 : 0));
+	}
+
+	stats.frames++;
+	stats.frames_per_target[i]++;
+}
@@ -0,0 +1,91 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Receives on several spreading factors and channels with one radio by cycling CAD over them.
+ */
+
+#ifndef __LLCC68_CAD_SCANNER_H__
+#define __LLCC68_CAD_SCANNER_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Runs CAD on one SF/channel pair after the other and receives on the first pair where a
+	 * preamble is detected. Pairs that carried more of the recent frames are visited more often,
+	 * every pair keeps a minimum share of the visits so new traffic is still found.
+	 * Frames are only caught if their preamble outlasts a scan cycle, so keep preambles long.
+	 * CAD thresholds are only tuned for BW 125kHz, so the active bandwidth must be 125kHz.
+	 */
+	class CAD_Scanner
+	{
+	public:
+		static constexpr uint8_t max_targets = 8;
+		/* Visit weight of a pair without traffic, a pair carrying all traffic weighs 256 more */
+		static constexpr uint16_t min_weight = 16;
+
+		typedef struct
+		{
+			uint32_t frequency; /* Hz */
+			LLCC68_Constants::SF sf;
+
+		} Target;
+
+		typedef struct
+		{
+			uint32_t cads;
+			uint32_t detections;
+			uint32_t false_detections; /* CAD fired but no frame followed */
+			uint32_t frames;
+			uint32_t frames_per_target[max_targets];
+
+		} Stats;
+
+		explicit CAD_Scanner(LLCC68 &radio);
+
+		/**
+		 * @brief Adds a pair, using the rest of the active LoRa config.
+		 * @return false if the list is full, the active bandwidth isn't 125kHz or the SF isn't supported with it.
+		 */
+		bool add_target(uint32_t frequency, LLCC68_Constants::SF sf);
+		/**
+		 * @brief Scans until a frame is received. The radio is left tuned to the pair of the last CAD.
+		 * @param target Optional, set to the index of the pair the frame was received on.
+		 * @return Amount of bytes stored in buffer, 0 on timeout.
+		 */
+		uint8_t receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint8_t *target = nullptr);
+
+		/* Visits every pair equally when disabled, for comparison. Enabled by default. */
+		inline void set_adaptive(bool enable) { adaptive = enable; }
+		inline const Target &get_target(uint8_t i) const { return targets[i]; }
+		inline uint8_t get_target_count() const { return n_targets; }
+		/* Share of recent frames on the pair, 256 is all of them */
+		inline uint16_t get_traffic(uint8_t i) const { return traffic_q8[i]; }
+		inline const Stats &get_stats() const { return stats; }
+		inline ErrorCode get_last_error() const { return last_error; }
+
+	private:
+		/* Smooth weighted round robin, see min_weight */
+		uint8_t next_target();
+		bool tune(uint8_t i);
+		/* Waits for CadDone, false if the device didn't finish in time */
+		bool run_cad(uint8_t i, bool *detected);
+		void record_frame(uint8_t i);
+
+		LLCC68 &radio;
+		Target targets[max_targets];
+		uint16_t traffic_q8[max_targets];
+		int32_t credit[max_targets];
+		uint8_t n_targets;
+		bool adaptive;
+		Stats stats;
+		ErrorCode last_error;
+	};
+}
+
+#endif // __LLCC68_CAD_SCANNER_H__
@@ -0,0 +1,361 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "compressor.h"
+#include <cstring>
+
+using LoRa::Payload_Compressor;
+
+namespace
+{
+	/* Token byte limits */
+	constexpr uint8_t max_literals = 128;
+	constexpr uint8_t min_match = 3;
+	constexpr uint8_t max_match = 127 + min_match;
+	/* Offsets below this take one byte */
+	constexpr uint16_t short_offset = 0x80;
+
+	uint32_t zigzag(int32_t value)
+	{
+		return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+	}
+
+	int32_t unzigzag(uint32_t value)
+	{
+		return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+	}
+}
+
+const uint8_t Payload_Compressor::default_dictionary[] =
+	"\"firmware\":\"uptime\":\"error\":\"timestamp\":\"current\":\"pressure\":\"humidity\":\"voltage\":"
+	"\"battery\":\"status\":\"alarm\":\"rssi\":\"snr\":\"lat\":\"lon\":\"id\":\"temp\":"
+	"null,false,true,\"ok\"},{\"\":\"\",\"\":{\"";
+const uint16_t Payload_Compressor::default_dictionary_size = sizeof(default_dictionary) - 1;
+
+Payload_Compressor::Payload_Compressor(LLCC68 &radio, const uint8_t *dictionary, uint16_t dictionary_size)
+	: radio{radio}, dictionary{dictionary},
+	  dictionary_size{(dictionary == nullptr) ? uint16_t{0} : ((dictionary_size > max_dictionary_size) ? max_dictionary_size : dictionary_size)},
+	  enabled{true}, frame{}, stats{}, last_error{ErrorCode::NO_ERROR}
+{
+}
+
+bool LoRa::Payload_Compressor::send(const uint8_t *payload, uint8_t size)
+{
+	if (size > max_payload_size)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	const uint8_t compressed = enabled ? compress(payload, size, frame) : 0;
+
+	if (compressed != 0)
+	{
+		return transmit(Format::LZ, frame, compressed, size);
+	}
+
+	return transmit(Format::RAW, payload, size, size);
+}
+
+bool LoRa::Payload_Compressor::send_series(const int32_t *values, uint8_t n)
+{
+	const uint8_t size = encode_series(values, n, frame, max_payload_size);
+
+	if ((n == 0) || (size == 0))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	return transmit(Format::SERIES, frame, size, static_cast<uint16_t>(n * sizeof(int32_t)));
+}
+
+uint8_t LoRa::Payload_Compressor::receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, Format *format)
+{
+	const uint8_t size = radio.receive_packet(frame, sizeof(frame), timeout_ms);
+
+	if (size == 0)
+	{
+		last_error = radio.get_last_error();
+		return 0;
+	}
+
+	const uint8_t payload_size = open(frame, size, buffer, max_size, format);
+	last_error = (payload_size == 0) ? ErrorCode::INVALID_PARAMETER : ErrorCode::NO_ERROR;
+
+	return payload_size;
+}
+
+uint8_t LoRa::Payload_Compressor::open(const uint8_t *frame, uint8_t size, uint8_t *payload, uint8_t max_size, Format *format) const
+{
+	if (size < 1)
+	{
+		return 0;
+	}
+
+	const Format received = static_cast<Format>(frame[0]);
+	const uint8_t body_size = size - 1;
+
+	if (format != nullptr)
+	{
+		*format = received;
+	}
+
+	switch (received)
+	{
+	case Format::RAW:
+	case Format::SERIES:
+		if (body_size > max_size)
+		{
+			return 0;
+		}
+		memcpy(payload, frame + 1, body_size);
+		return body_size;
+
+	case Format::LZ:
+		return decompress(frame + 1, body_size, payload, max_size);
+
+	default:
+		return 0;
+	}
+}
+
+uint8_t LoRa::Payload_Compressor::compress(const uint8_t *in, uint8_t size, uint8_t *out) const
+{
+	uint16_t used = 0;
+	uint16_t literals = 0;
+	uint16_t i = 0;
+
+	/* Emits the pending literals, false once the output is no longer smaller than the input */
+	auto flush = [&]() -> bool
+	{
+		const uint8_t *run = in + i - literals;
+
+		while (literals > 0)
+		{
+			const uint8_t n = (literals > max_literals) ? max_literals : static_cast<uint8_t>(literals);
+
+			if (used + 1 + n >= size)
+			{
+				return false;
+			}
+			out[used++] = static_cast<uint8_t>(n - 1);
+			memcpy(out + used, run, n);
+			used += n;
+			run += n;
+			literals -= n;
+		}
+
+		return true;
+	};
+
+	while (i < size)
+	{
+		const uint16_t position = dictionary_size + i;
+		const uint16_t longest = ((size - i) > max_match) ? max_match : (size - i);
+		uint16_t best_length = 0;
+		uint16_t best_offset = 0;
+		int16_t best_gain = 0;
+
+		/* Nearest candidates first, so equal matches get the shortest offset */
+		for (uint16_t candidate = position; (candidate-- > 0) && (longest >= min_match);)
+		{
+			if (at(in, candidate) != in[i])
+			{
+				continue;
+			}
+
+			uint16_t length = 1;
+			while ((length < longest) && (at(in, candidate + length) == in[i + length]))
+			{
+				length++;
+			}
+
+			const uint16_t offset = position - candidate;
+			const int16_t gain = static_cast<int16_t>(length - ((offset < short_offset) ? 2 : 3));
+
+			if (gain > best_gain)
+			{
+				best_gain = gain;
+				best_length = length;
+				best_offset = offset;
+			}
+			if (length == longest)
+			{
+				break;
+			}
+		}
+
+		/* A match must save at least a byte over the literals it replaces */
+		if ((best_length < min_match) || (best_gain < 1))
+		{
+			literals++;
+			i++;
+			continue;
+		}
+
+		if (!flush() || (used + ((best_offset < short_offset) ? 2 : 3) >= size))
+		{
+			return 0;
+		}
+
+		out[used++] = static_cast<uint8_t>(0x80 | (best_length - min_match));
+		if (best_offset < short_offset)
+		{
+			out[used++] = static_cast<uint8_t>(best_offset);
+		}
+		else
+		{
+			out[used++] = static_cast<uint8_t>(0x80 | (best_offset & 0x7F));
+			out[used++] = static_cast<uint8_t>(best_offset >> 7);
+		}
+		i += best_length;
+	}
+
+	if (!flush())
+	{
+		return 0;
+	}
+
+	return static_cast<uint8_t>(used);
+}
+
+uint8_t LoRa::Payload_Compressor::decompress(const uint8_t *in, uint8_t size, uint8_t *out, uint8_t max_size) const
+{
+	uint16_t i = 0;
+	uint16_t used = 0;
+
+	while (i < size)
+	{
+		const uint8_t token = in[i++];
+
+		if ((token & 0x80) == 0)
+		{
+			const uint16_t n = (token & 0x7F) + 1;
+
+			if ((i + n > size) || (used + n > max_size))
+			{
+				return 0;
+			}
+			memcpy(out + used, in + i, n);
+			i += n;
+			used += n;
+			continue;
+		}
+
+		const uint16_t length = (token & 0x7F) + min_match;
+
+		if (i >= size)
+		{
+			return 0;
+		}
+		uint16_t offset = in[i++];
+		if (offset & 0x80)
+		{
+			if (i >= size)
+			{
+				return 0;
+			}
+			offset = static_cast<uint16_t>((offset & 0x7F) | (in[i++] << 7));
+		}
+
+		if ((offset == 0) || (offset > dictionary_size + used) || (used + length > max_size))
+		{
+			return 0;
+		}
+
+		/* Byte by byte, the source may overlap what is being written */
+		const uint16_t from = dictionary_size + used - offset;
+		for (uint16_t k = 0; k < length; k++)
+		{
+			out[used] = at(out, from + k);
+			used++;
+		}
+	}
+
+	return static_cast<uint8_t>(used);
+}
+
+uint8_t LoRa::Payload_Compressor::encode_series(const int32_t *values, uint8_t n, uint8_t *out, uint8_t max_size)
+{
+	uint16_t used = 0;
+	uint32_t previous = 0;
+
+	for (uint8_t k = 0; k < n; k++)
+	{
+		/* Wrapping difference, decoding adds it back with the same wrap */
+		uint32_t value = zigzag(static_cast<int32_t>(static_cast<uint32_t>(values[k]) - previous));
+		previous = static_cast<uint32_t>(values[k]);
+
+		do
+		{
+			if (used >= max_size)
+			{
+				return 0;
+			}
+			out[used++] = static_cast<uint8_t>((value & 0x7F) | ((value > 0x7F) ? 0x80 : 0));
+			value >>= 7;
+		} while (value != 0);
+	}
+
+	return static_cast<uint8_t>(used);
+}
+
+uint8_t LoRa::Payload_Compressor::decode_series(const uint8_t *in, uint8_t size, int32_t *values, uint8_t max_values)
+{
+	uint16_t i = 0;
+	uint8_t n = 0;
+	uint32_t previous = 0;
+
+	while (i < size)
+	{
+		uint32_t value = 0;
+		uint8_t shift = 0;
+		uint8_t byte;
+
+		do
+		{
+			if ((i >= size) || (shift > 28))
+			{
+				return 0;
+			}
+			byte = in[i++];
+			value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+
+		if (n == max_values)
+		{
+			return 0;
+		}
+		previous += static_cast<uint32_t>(unzigzag(value));
+		values[n++] = static_cast<int32_t>(previous);
+	}
+
+	return n;
+}
+
+bool LoRa::Payload_Compressor::transmit(Format format, const uint8_t *body, uint8_t size, uint16_t payload_size)
+{
+	const uint8_t format_byte = static_cast<uint8_t>(format);
+	const Segment segments[] = {{&format_byte, 1}, {body, size}};
+
+	radio.clear_last_error();
+	radio.send_packet(segments, 2);
+	last_error = radio.get_last_error();
+	if (last_error != ErrorCode::NO_ERROR)
+	{
+		return false;
+	}
+
+	stats.frames++;
+	stats.compressed += (format != Format::RAW) ? 1 : 0;
+	stats.bytes_in += payload_size;
+	stats.bytes_out += size + 1;
+
+	return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Payload compression on top of LLCC68.
+ * Frame layout: [format 1][body]. Bodies are the payload as is, LZ compressed, or a delta/varint coded series.
+ */
+
+#ifndef __LLCC68_COMPRESSOR_H__
+#define __LLCC68_COMPRESSOR_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief LZ77 against a dictionary both ends share, so even short frames find matches. Tokens:
+	 * 0LLLLLLL followed by L + 1 literals, or 1LLLLLLL followed by a 1-2 byte varint offset to copy
+	 * L + 3 bytes from. Offsets reach back into the dictionary, which precedes the payload.
+	 * Each frame is sent compressed only if that makes it smaller. No allocation, no state between frames.
+	 */
+	class Payload_Compressor
+	{
+	public:
+		static constexpr uint8_t max_payload_size = 254;
+		static constexpr uint16_t max_dictionary_size = 512;
+
+		enum class Format : uint8_t
+		{
+			RAW = 0,
+			LZ = 1,
+			SERIES = 2
+
+		};
+
+		typedef struct
+		{
+			uint32_t frames;
+			uint32_t compressed; /* Frames not sent RAW */
+			uint64_t bytes_in;	 /* Payload bytes handed to send */
+			uint64_t bytes_out;	 /* Frame bytes sent, format byte included */
+
+		} Stats;
+
+		/* Tokens of JSON-ish telemetry */
+		static const uint8_t default_dictionary[];
+		static const uint16_t default_dictionary_size;
+
+		/**
+		 * @param dictionary Must be the same on both ends and outlive the compressor. Put the most
+		 * frequent strings at the end, they get the shortest offsets.
+		 */
+		Payload_Compressor(LLCC68 &radio, const uint8_t *dictionary = default_dictionary, uint16_t dictionary_size = default_dictionary_size);
+
+		/**
+		 * @brief Sends the payload, LZ compressed if that is smaller.
+		 * @return false if the payload is too large or the radio failed to send. Check get_last_error().
+		 */
+		bool send(const uint8_t *payload, uint8_t size);
+		/**
+		 * @brief Sends the values as a delta/varint coded series.
+		 * @return false if the series doesn't fit in a frame or the radio failed to send. Check get_last_error().
+		 */
+		bool send_series(const int32_t *values, uint8_t n);
+		/**
+		 * @brief Receives a frame, see open().
+		 */
+		uint8_t receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, Format *format = nullptr);
+		/**
+		 * @brief Restores the payload of a received frame. SERIES bodies are copied as is, pass them to decode_series().
+		 * @return Payload size, 0 if the frame is malformed or the payload doesn't fit.
+		 */
+		uint8_t open(const uint8_t *frame, uint8_t size, uint8_t *payload, uint8_t max_size, Format *format = nullptr) const;
+
+		/* @return Compressed size, 0 if it isn't smaller than the input */
+		uint8_t compress(const uint8_t *in, uint8_t size, uint8_t *out) const;
+		/* @return Decompressed size, 0 if the input is malformed or the output exceeds max_size */
+		uint8_t decompress(const uint8_t *in, uint8_t size, uint8_t *out, uint8_t max_size) const;
+		/**
+		 * @brief First value and the differences to the previous value, zigzag varints.
+		 * @return Encoded size, 0 if it exceeds max_size.
+		 */
+		static uint8_t encode_series(const int32_t *values, uint8_t n, uint8_t *out, uint8_t max_size);
+		/* @return Amount of values, 0 if the input is malformed or has more than max_values */
+		static uint8_t decode_series(const uint8_t *in, uint8_t size, int32_t *values, uint8_t max_values);
+
+		/* Turns LZ off, frames are sent RAW with the format byte still in place */
+		inline void set_enabled(bool enable) { enabled = enable; }
+		inline const Stats &get_stats() const { return stats; }
+		inline ErrorCode get_last_error() const { return last_error; }
+
+	private:
+		/* Dictionary followed by data */
+		inline uint8_t at(const uint8_t *data, uint16_t position) const
+		{
+			return (position < dictionary_size) ? dictionary[position] : data[position - dictionary_size];
+		}
+
+		/* Sends and counts the frame, false with the radio error if sending failed */
+		bool transmit(Format format, const uint8_t *body, uint8_t size, uint16_t payload_size);
+
+		LLCC68 &radio;
+		const uint8_t *dictionary;
+		uint16_t dictionary_size;
+		bool enabled;
+		uint8_t frame[255];
+		Stats stats;
+		ErrorCode last_error;
+	};
+}
+
+#endif // __LLCC68_COMPRESSOR_H__
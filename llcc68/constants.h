@@ -151,6 +151,105 @@ namespace LoRa
 
 		};
 
+		/* GFSK modulation shaping */
+		enum class PulseShape : uint8_t
+		{
+			NO_FILTER = 0x00,
+			GAUSSIAN_BT_0_3 = 0x08,
+			GAUSSIAN_BT_0_5 = 0x09,
+			GAUSSIAN_BT_0_7 = 0x0A,
+			GAUSSIAN_BT_1 = 0x0B
+
+		};
+
+		/* GFSK RX bandwidth, double sided */
+		enum class GFSK_BW : uint8_t
+		{
+			RX_BW_4800 = 0x1F,
+			RX_BW_5800 = 0x17,
+			RX_BW_7300 = 0x0F,
+			RX_BW_9700 = 0x1E,
+			RX_BW_11700 = 0x16,
+			RX_BW_14600 = 0x0E,
+			RX_BW_19500 = 0x1D,
+			RX_BW_23400 = 0x15,
+			RX_BW_29300 = 0x0D,
+			RX_BW_39000 = 0x1C,
+			RX_BW_46900 = 0x14,
+			RX_BW_58600 = 0x0C,
+			RX_BW_78200 = 0x1B,
+			RX_BW_93800 = 0x13,
+			RX_BW_117300 = 0x0B,
+			RX_BW_156200 = 0x1A,
+			RX_BW_187200 = 0x12,
+			RX_BW_234300 = 0x0A,
+			RX_BW_312000 = 0x19,
+			RX_BW_373600 = 0x11,
+			RX_BW_467000 = 0x09
+
+		};
+
+		enum class PreambleDetector : uint8_t
+		{
+			OFF = 0x00,
+			BITS_8 = 0x04,
+			BITS_16 = 0x05,
+			BITS_24 = 0x06,
+			BITS_32 = 0x07
+
+		};
+
+		/* GFSK address filtering */
+		enum class AddrComp : uint8_t
+		{
+			FILTERING_DISABLE = 0x00,
+			NODE = 0x01,
+			NODE_BROADCAST = 0x02
+
+		};
+
+		enum class GFSK_PacketType : uint8_t
+		{
+			/* Known length, no length byte on air */
+			FIXED_LENGTH = 0x00,
+			VARIABLE_LENGTH = 0x01
+
+		};
+
+		enum class GFSK_CRC_Type : uint8_t
+		{
+			CRC_1_BYTE = 0x00,
+			CRC_OFF = 0x01,
+			CRC_2_BYTE = 0x02,
+			CRC_1_BYTE_INV = 0x04,
+			CRC_2_BYTE_INV = 0x06
+
+		};
+
+		enum class Whitening : uint8_t
+		{
+			OFF = 0x00,
+			ON = 0x01
+
+		};
+
+		enum class CadSymbolNum : uint8_t
+		{
+			CAD_ON_1_SYMB = 0x00,
+			CAD_ON_2_SYMB = 0x01,
+			CAD_ON_4_SYMB = 0x02,
+			CAD_ON_8_SYMB = 0x03,
+			CAD_ON_16_SYMB = 0x04
+
+		};
+
+		enum class CadExitMode : uint8_t
+		{
+			CAD_ONLY = 0x00, /* Back to STDBY_RC after CAD */
+			CAD_RX = 0x01	 /* Stays in RX if activity is detected */
+
+		};
+
 		enum class SleepConfig_StartType : uint8_t
 		{
 			COLD_START = 0,
@@ -183,7 +282,8 @@ namespace LoRa
 			CrcErr = 1 << 6,
 			CadDone = 1 << 7,
 			CadDetected = 1 << 8,
-			Timeout = 1 << 9
+			Timeout = 1 << 9,
+			All = 0x03FF
 
 		};
 	};
@@ -0,0 +1,216 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "duty_cycle.h"
+
+using LoRa::DutyCycle_Scheduler;
+
+DutyCycle_Scheduler::DutyCycle_Scheduler(LLCC68 &radio, int64_t window_ms)
+	: radio{radio}, window_ms{window_ms}, sub_bands{}, channels{}, n_sub_bands{0}, n_channels{0}, current_channel{-1}
+{
+}
+
+int8_t LoRa::DutyCycle_Scheduler::add_sub_band(uint32_t min_freq, uint32_t max_freq, uint16_t duty_cycle)
+{
+	if ((n_sub_bands >= max_sub_bands) || (min_freq > max_freq) || (duty_cycle == 0) || (duty_cycle > 10000))
+	{
+		return -1;
+	}
+
+	SubBand &sub_band = sub_bands[n_sub_bands];
+	sub_band.min_freq = min_freq;
+	sub_band.max_freq = max_freq;
+	/* window_ms * 1000 us * duty_cycle / 10000 */
+	sub_band.budget = static_cast<uint64_t>(window_ms) * duty_cycle / 10;
+	sub_band.used = 0;
+	sub_band.head = 0;
+	sub_band.count = 0;
+
+	return static_cast<int8_t>(n_sub_bands++);
+}
+
+int8_t LoRa::DutyCycle_Scheduler::add_channel(uint32_t freq)
+{
+	if (n_channels >= max_channels)
+	{
+		return -1;
+	}
+
+	for (uint8_t i = 0; i < n_sub_bands; i++)
+	{
+		if ((freq >= sub_bands[i].min_freq) && (freq <= sub_bands[i].max_freq))
+		{
+			channels[n_channels].freq = freq;
+			channels[n_channels].sub_band = i;
+
+			if ((current_channel < 0) || (freq == radio.get_frequency()))
+			{
+				current_channel = static_cast<int8_t>(n_channels);
+			}
+
+			return static_cast<int8_t>(n_channels++);
+		}
+	}
+
+	return -1;
+}
+
+bool LoRa::DutyCycle_Scheduler::send_packet(const uint8_t *packet, uint8_t size, int64_t *retry_in_ms)
+{
+	const int64_t now = radio.get_device().timestamp_64();
+	const uint32_t airtime = radio.get_time_on_air(size);
+
+	for (uint8_t i = 0; i < n_sub_bands; i++)
+	{
+		expire(sub_bands[i], now);
+	}
+
+	const int8_t channel = select_channel(now, airtime);
+
+	if (channel < 0)
+	{
+		if (retry_in_ms != nullptr)
+		{
+			*retry_in_ms = get_next_admission(size);
+		}
+		return false;
+	}
+
+	if ((channel != current_channel) || (channels[channel].freq != radio.get_frequency()))
+	{
+		radio.set_frequency(channels[channel].freq);
+		current_channel = channel;
+	}
+
+	/* Recorded before sending, a failed transmission may still have used the air */
+	record(sub_bands[channels[channel].sub_band], now, airtime);
+	radio.send_packet(packet, size);
+
+	return true;
+}
+
+int64_t LoRa::DutyCycle_Scheduler::get_next_admission(uint8_t size)
+{
+	const int64_t now = radio.get_device().timestamp_64();
+	const uint32_t airtime = radio.get_time_on_air(size);
+	int64_t next = -1;
+
+	for (uint8_t i = 0; i < n_channels; i++)
+	{
+		SubBand &sub_band = sub_bands[channels[i].sub_band];
+		expire(sub_band, now);
+
+		const int64_t t = time_until_fits(sub_band, now, airtime);
+		if ((t >= 0) && ((next < 0) || (t < next)))
+		{
+			next = t;
+		}
+	}
+
+	return next;
+}
+
+uint64_t LoRa::DutyCycle_Scheduler::get_available_airtime(uint8_t sub_band)
+{
+	if (sub_band >= n_sub_bands)
+	{
+		return 0;
+	}
+
+	SubBand &band = sub_bands[sub_band];
+	expire(band, radio.get_device().timestamp_64());
+
+	return (band.used < band.budget) ? (band.budget - band.used) : 0;
+}
+
+void LoRa::DutyCycle_Scheduler::expire(SubBand &sub_band, int64_t now)
+{
+	while ((sub_band.count > 0) && ((sub_band.history[sub_band.head].timestamp + window_ms) <= now))
+	{
+		sub_band.used -= sub_band.history[sub_band.head].airtime;
+		sub_band.head = (sub_band.head + 1) % history_depth;
+		sub_band.count--;
+	}
+}
+
+void LoRa::DutyCycle_Scheduler::record(SubBand &sub_band, int64_t now, uint32_t airtime)
+{
+	if (sub_band.count == history_depth)
+	{
+		/**
+		 * Merge the two oldest entries. The merged entry expires with the newer one,
+		 * so the budget is only ever under-estimated.
+		 */
+		const uint8_t next = (sub_band.head + 1) % history_depth;
+		sub_band.history[next].airtime += sub_band.history[sub_band.head].airtime;
+		sub_band.head = next;
+		sub_band.count--;
+	}
+
+	const uint8_t tail = (sub_band.head + sub_band.count) % history_depth;
+	sub_band.history[tail].timestamp = now;
+	sub_band.history[tail].airtime = airtime;
+	sub_band.count++;
+	sub_band.used += airtime;
+}
+
+int64_t LoRa::DutyCycle_Scheduler::time_until_fits(const SubBand &sub_band, int64_t now, uint32_t airtime) const
+{
+	if (airtime > sub_band.budget)
+	{
+		return -1;
+	}
+
+	uint64_t used = sub_band.used;
+
+	if (used + airtime <= sub_band.budget)
+	{
+		return 0;
+	}
+
+	for (uint8_t i = 0; i < sub_band.count; i++)
+	{
+		const Transmission &tx = sub_band.history[(sub_band.head + i) % history_depth];
+		used -= tx.airtime;
+		if (used + airtime <= sub_band.budget)
+		{
+			return tx.timestamp + window_ms - now;
+		}
+	}
+
+	return -1;
+}
+
+int8_t LoRa::DutyCycle_Scheduler::select_channel(int64_t now, uint32_t airtime)
+{
+	if ((current_channel >= 0) && (time_until_fits(sub_bands[channels[current_channel].sub_band], now, airtime) == 0))
+	{
+		return current_channel;
+	}
+
+	int8_t best = -1;
+	uint64_t best_left = 0;
+
+	/* Spread over the sub-band with the most budget left */
+	for (uint8_t i = 0; i < n_channels; i++)
+	{
+		const SubBand &sub_band = sub_bands[channels[i].sub_band];
+		if (time_until_fits(sub_band, now, airtime) != 0)
+		{
+			continue;
+		}
+
+		const uint64_t left = sub_band.budget - sub_band.used;
+		if ((best < 0) || (left > best_left))
+		{
+			best = static_cast<int8_t>(i);
+			best_left = left;
+		}
+	}
+
+	return best;
+}
@@ -0,0 +1,110 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Regulatory duty-cycle scheduler in front of the LLCC68 driver.
+ */
+
+#ifndef __LLCC68_DUTY_CYCLE_H__
+#define __LLCC68_DUTY_CYCLE_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Tracks time on air per sub-band over a sliding window and admits packets
+	 * as long as the sub-band budget allows. When the budget of the current channel is
+	 * exhausted, the packet is moved to a channel of another sub-band with budget left.
+	 */
+	class DutyCycle_Scheduler
+	{
+	public:
+		static constexpr uint8_t max_sub_bands = 8;
+		static constexpr uint8_t max_channels = 16;
+		/* Transmissions remembered per sub-band. Older ones are merged, never dropped. */
+		static constexpr uint8_t history_depth = 32;
+
+		/**
+		 * @param window_ms Length of the sliding window. ETSI uses one hour.
+		 */
+		explicit DutyCycle_Scheduler(LLCC68 &radio, int64_t window_ms = 3600000);
+
+		/**
+		 * @param min_freq Lower edge in Hz.
+		 * @param max_freq Upper edge in Hz.
+		 * @param duty_cycle In 1/10000 units, e.g. 100 is 1%.
+		 * @return Sub-band index, -1 if there is no room left.
+		 */
+		int8_t add_sub_band(uint32_t min_freq, uint32_t max_freq, uint16_t duty_cycle);
+		/**
+		 * @brief Adds a channel, the sub-band is looked up from its frequency.
+		 * @return Channel index, -1 if the frequency is not in any sub-band.
+		 */
+		int8_t add_channel(uint32_t freq);
+
+		/**
+		 * @brief Sends the packet if any sub-band has budget for it, preferring the current channel.
+		 * @param retry_in_ms Optional. Set to the time until the packet can be admitted when it is deferred.
+		 * @return false if the packet is deferred.
+		 */
+		bool send_packet(const uint8_t *packet, uint8_t size, int64_t *retry_in_ms = nullptr);
+		/**
+		 * @brief Time until a packet of the given size can be admitted on any channel.
+		 * @return 0 if it can be sent now, -1 if it can never fit in the budget.
+		 */
+		int64_t get_next_admission(uint8_t size);
+		/**
+		 * @return Remaining time on air of the sub-band within the current window, in microseconds.
+		 */
+		uint64_t get_available_airtime(uint8_t sub_band);
+		inline int8_t get_current_channel() const { return current_channel; }
+
+	private:
+		typedef struct
+		{
+			int64_t timestamp; /* ms, start of the transmission */
+			uint32_t airtime;  /* us */
+
+		} Transmission;
+
+		typedef struct
+		{
+			uint32_t min_freq;
+			uint32_t max_freq;
+			uint64_t budget; /* us per window */
+			uint64_t used;	 /* us, sum of the history */
+			Transmission history[history_depth];
+			uint8_t head;
+			uint8_t count;
+
+		} SubBand;
+
+		typedef struct
+		{
+			uint32_t freq;
+			uint8_t sub_band;
+
+		} Channel;
+
+		void expire(SubBand &sub_band, int64_t now);
+		void record(SubBand &sub_band, int64_t now, uint32_t airtime);
+		/* ms until airtime fits in the sub-band, -1 if it never does */
+		int64_t time_until_fits(const SubBand &sub_band, int64_t now, uint32_t airtime) const;
+		int8_t select_channel(int64_t now, uint32_t airtime);
+
+		LLCC68 &radio;
+		int64_t window_ms;
+
+		SubBand sub_bands[max_sub_bands];
+		Channel channels[max_channels];
+		uint8_t n_sub_bands;
+		uint8_t n_channels;
+		int8_t current_channel;
+	};
+}
+
+#endif // __LLCC68_DUTY_CYCLE_H__
@@ -8,15 +8,33 @@
 #include "llcc68.h"
 #include "opcodes.h"
 #include <cassert>
+#include <cstring>
 
 using LoRa::LLCC68;
 
+namespace
+{
+	/* Registers this many addresses apart still share a transaction, the bytes in between are cheaper than a new one */
+	constexpr uint16_t register_merge_gap = 3;
+
+	LoRa::RegisterAccess write_byte(uint16_t address, uint8_t value)
+	{
+		return LoRa::RegisterAccess{address, 0xFF, value, nullptr};
+	}
+}
+
 LLCC68::LLCC68(const LLCC68_pins &pins,
 					   const LLCC68_config &config,
 					   std::unique_ptr<LoRa_SPI> spi,
 					   std::unique_ptr<LoRa_IO> io,
 					   std::unique_ptr<Device> device)
-	: last_error{ErrorCode::NO_ERROR}, pins{pins}, config{config}, _spi{std::move(spi)}, _io{std::move(io)}, _device{std::move(device)}
+	: last_error{ErrorCode::NO_ERROR}, pins{pins}, config{config}, _spi{std::move(spi)}, _io{std::move(io)}, _device{std::move(device)},
+	  active_packet_type{config.packet_type}, active_packet_params{}, active_packet_params_size{0},
+	  parked_packet_params{}, parked_packet_params_size{0}, lora_modulation_params{}, gfsk_modulation_params{},
+	  fixed_frames{}, filtered_packets{0}, dio1_edge_us{0}, dio1_edge_latched{false}, irq_time_us{0}, tx_time{}, rx_time{},
+	  current_table{llcc68_default_currents}, energy{}, radio_state{RadioState::STDBY_RC}, state_since_us{-1},
+	  tx_power_dbm{config.tx_params.power_dbm}, rx_continuous{false}, register_cache{}, n_cached_registers{0}, next_evicted_register{0},
+	  capture_sink{nullptr}
 {
 	if (!_spi->is_bit_order_msb_first())
 	{
@@ -31,6 +49,9 @@ void LoRa::LLCC68::reset()
 	_device->delay(2);
 	_io->write(pins.nreset, IO_HIGH);
 	_device->delay(20);
+
+	invalidate_register_cache();
+	enter_state(RadioState::STDBY_RC);
 }
 
 void LoRa::LLCC68::sleep(SleepConfig sleepConfig)
@@ -46,6 +67,8 @@ void LoRa::LLCC68::set_standby(LLCC68_Constants::StandbyConfig standbyConfig)
 	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_STANDBY));
 	_spi->transfer(static_cast<uint8_t>(standbyConfig));
 	_spi->end_transfer();
+
+	enter_state((standbyConfig == LLCC68_Constants::StandbyConfig::STDBY_XOSC) ? RadioState::STDBY_XOSC : RadioState::STDBY_RC);
 }
 
 uint32_t LoRa::LLCC68::calculate_rf_frequency(uint32_t desired_freq)
@@ -53,6 +76,256 @@ uint32_t LoRa::LLCC68::calculate_rf_frequency(uint32_t desired_freq)
 	return std::floor(static_cast<double>(desired_freq) / LLCC68_Constants::freq_step);
 }
 
+uint32_t LoRa::LLCC68::calculate_timer_steps(uint32_t us)
+{
+	/* us / 15.625 */
+	return static_cast<uint32_t>((static_cast<uint64_t>(us) * 64) / 1000);
+}
+
+uint32_t LoRa::LLCC68::calculate_symbol_time(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw)
+{
+	uint32_t bw_khz = 125;
+
+	if (bw == LLCC68_Constants::BW::LORA_BW_250)
+	{
+		bw_khz = 250;
+	}
+	else if (bw == LLCC68_Constants::BW::LORA_BW_500)
+	{
+		bw_khz = 500;
+	}
+
+	return ((1UL << static_cast<uint8_t>(sf)) * 1000UL) / bw_khz;
+}
+
+uint32_t LoRa::LLCC68::calculate_time_on_air(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldro,
+											 uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, LLCC68_Constants::CRC_Type crcType, uint8_t payloadLength)
+{
+	const int32_t n_sf = static_cast<int32_t>(sf);
+	const int32_t n_cr = static_cast<int32_t>(cr);
+	const int32_t crc = (crcType == LLCC68_Constants::CRC_Type::CRC_ON) ? 16 : 0;
+	const int32_t header = (headerType == LLCC68_Constants::HeaderType::EXPLICIT_HEADER) ? 20 : 0;
+
+	/* Both values are in quarter symbols to keep the .25 fractions exact */
+	int32_t n_preamble = 4 * static_cast<int32_t>(preambleLength);
+	int32_t bits = 8 * static_cast<int32_t>(payloadLength) + crc - 4 * n_sf + header;
+	int32_t bits_per_block = 4 * n_sf;
+
+	if (n_sf <= 6)
+	{
+		n_preamble += 25;
+	}
+	else
+	{
+		n_preamble += 17;
+		bits += 8;
+		if (ldro == LLCC68_Constants::LDRO::ON)
+		{
+			bits_per_block = 4 * (n_sf - 2);
+		}
+	}
+
+	if (bits < 0)
+	{
+		bits = 0;
+	}
+
+	const int32_t n_payload = 8 + ((bits + bits_per_block - 1) / bits_per_block) * (n_cr + 4);
+	const uint64_t quarter_symbols = static_cast<uint64_t>(n_preamble + 4 * n_payload);
+	return static_cast<uint32_t>((quarter_symbols * calculate_symbol_time(sf, bw)) / 4);
+}
+
+uint32_t LoRa::LLCC68::calculate_gfsk_time_on_air(uint32_t bitrate, uint16_t preambleLength, uint8_t syncWordLength, LLCC68_Constants::AddrComp addrComp,
+												  LLCC68_Constants::GFSK_PacketType packetType, LLCC68_Constants::GFSK_CRC_Type crcType, uint8_t payloadLength)
+{
+	uint32_t bits = static_cast<uint32_t>(preambleLength) + syncWordLength + 8 * static_cast<uint32_t>(payloadLength);
+
+	if (packetType == LLCC68_Constants::GFSK_PacketType::VARIABLE_LENGTH)
+	{
+		bits += 8;
+	}
+	if (addrComp != LLCC68_Constants::AddrComp::FILTERING_DISABLE)
+	{
+		bits += 8;
+	}
+	if ((crcType == LLCC68_Constants::GFSK_CRC_Type::CRC_1_BYTE) || (crcType == LLCC68_Constants::GFSK_CRC_Type::CRC_1_BYTE_INV))
+	{
+		bits += 8;
+	}
+	else if ((crcType == LLCC68_Constants::GFSK_CRC_Type::CRC_2_BYTE) || (crcType == LLCC68_Constants::GFSK_CRC_Type::CRC_2_BYTE_INV))
+	{
+		bits += 16;
+	}
+
+	return static_cast<uint32_t>((static_cast<uint64_t>(bits) * 1000000ULL + bitrate - 1) / bitrate);
+}
+
+uint32_t LoRa::LLCC68::get_time_on_air(uint8_t payloadLength) const
+{
+	if (active_packet_type == LLCC68_Constants::PacketType::GFSK)
+	{
+		return calculate_gfsk_time_on_air(config.modulation_params._gfsk.bitrate,
+										  (static_cast<uint16_t>(active_packet_params[1]) << 8) | active_packet_params[2],
+										  active_packet_params[4],
+										  static_cast<LLCC68_Constants::AddrComp>(active_packet_params[5]),
+										  static_cast<LLCC68_Constants::GFSK_PacketType>(active_packet_params[6]),
+										  static_cast<LLCC68_Constants::GFSK_CRC_Type>(active_packet_params[8]),
+										  payloadLength);
+	}
+
+	const auto &lora = config.modulation_params._lora;
+	const uint16_t preambleLength = (static_cast<uint16_t>(active_packet_params[1]) << 8) | active_packet_params[2];
+
+	return calculate_time_on_air(lora.lora_sf, lora.bandwidth, lora.code_rate, lora.ldro,
+								 preambleLength,
+								 static_cast<LLCC68_Constants::HeaderType>(active_packet_params[3]),
+								 static_cast<LLCC68_Constants::CRC_Type>(active_packet_params[5]),
+								 payloadLength);
+}
+
+uint32_t LoRa::LLCC68::get_time_to_payload_bytes(uint8_t n) const
+{
+	const auto &lora = config.modulation_params._lora;
+	const int32_t n_sf = static_cast<int32_t>(lora.lora_sf);
+	const int32_t n_cr = static_cast<int32_t>(lora.code_rate);
+	const int32_t bits_per_block = 4 * ((lora.ldro == LLCC68_Constants::LDRO::ON) ? (n_sf - 2) : n_sf);
+
+	/* The header block carries the first payload bits along with the 20 header bits */
+	int32_t bits = 8 * static_cast<int32_t>(n) - (bits_per_block - 20);
+	if (bits < 0)
+	{
+		bits = 0;
+	}
+
+	/* One extra block for demodulation and buffer write latency */
+	const int32_t n_blocks = (bits + bits_per_block - 1) / bits_per_block + 1;
+
+	return static_cast<uint32_t>(n_blocks * (n_cr + 4)) * calculate_symbol_time(lora.lora_sf, lora.bandwidth);
+}
+
+bool LoRa::LLCC68::filter_matches(const RxFilter &filter, const uint8_t *payload)
+{
+	for (uint8_t i = 0; i < filter.length; i++)
+	{
+		if ((payload[i] & filter.mask[i]) != filter.value[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void LoRa::LLCC68::set_frequency(uint32_t desired_freq)
+{
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_rf_frequency(calculate_rf_frequency(desired_freq));
+	config.rf_freq = desired_freq;
+}
+
+int16_t LoRa::LLCC68::get_rssi_inst()
+{
+	/* Opcode, status, RssiInst in one burst */
+	uint8_t command[3] = {static_cast<uint8_t>(OPCODE::GET_RSSI_INST), static_cast<uint8_t>(OPCODE::NOP), static_cast<uint8_t>(OPCODE::NOP)};
+
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(command, sizeof(command));
+	_spi->end_transfer();
+
+	/* RSSI = -RssiInst / 2 */
+	return -static_cast<int16_t>(command[2] / 2);
+}
+
+LoRa::PacketStatus LoRa::LLCC68::get_packet_status()
+{
+	/* Opcode, status and three status bytes in one burst */
+	uint8_t command[5] = {static_cast<uint8_t>(OPCODE::GET_PACKET_STATUS), static_cast<uint8_t>(OPCODE::NOP),
+						  static_cast<uint8_t>(OPCODE::NOP), static_cast<uint8_t>(OPCODE::NOP), static_cast<uint8_t>(OPCODE::NOP)};
+	PacketStatus status{};
+
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(command, sizeof(command));
+	_spi->end_transfer();
+
+	if (active_packet_type == LLCC68_Constants::PacketType::LORA)
+	{
+		/* RssiPkt, SnrPkt in quarter dB, SignalRssiPkt */
+		const int8_t snr = static_cast<int8_t>(command[3]);
+
+		status.rssi = -static_cast<int16_t>(command[2] / 2);
+		status.snr = static_cast<int8_t>((snr >= 0) ? (snr + 2) / 4 : (snr - 2) / 4);
+		status.signal_rssi = -static_cast<int16_t>(command[4] / 2);
+	}
+	else
+	{
+		/* RxStatus, RssiSync, RssiAvg */
+		status.rssi = -static_cast<int16_t>(command[3] / 2);
+		status.signal_rssi = -static_cast<int16_t>(command[4] / 2);
+	}
+
+	return status;
+}
+
+uint8_t LoRa::LLCC68::scan_channels(const uint32_t *frequencies, uint8_t n_channels, ChannelNoise *result, uint8_t n_samples, uint32_t dwell_ms)
+{
+	if ((n_channels == 0) || (n_samples == 0) || (n_samples > max_rssi_samples))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return 0;
+	}
+
+	const uint32_t original_freq = config.rf_freq;
+	/* Microseconds, the defaults space samples 500us apart */
+	const int64_t spacing_us = static_cast<int64_t>(dwell_ms) * 1000 / n_samples;
+	int16_t samples[max_rssi_samples];
+	uint8_t quietest = 0;
+
+	for (uint8_t ch = 0; ch < n_channels; ch++)
+	{
+		set_frequency(frequencies[ch]);
+		set_rx(0x00FFFFFF); // Continuous, no IRQ needed
+
+		const int64_t first_us = _device->timestamp_us() + rssi_settle_us;
+
+		for (uint8_t i = 0; i < n_samples; i++)
+		{
+			/* Deadlines from the start, so time spent on SPI doesn't add up */
+			const int64_t at_us = first_us + i * spacing_us;
+			while (_device->timestamp_us() < at_us)
+			{
+			}
+
+			/* Insertion sort as we go, median is picked afterwards */
+			const int16_t rssi = get_rssi_inst();
+			uint8_t j = i;
+			while ((j > 0) && (samples[j - 1] > rssi))
+			{
+				samples[j] = samples[j - 1];
+				j--;
+			}
+			samples[j] = rssi;
+		}
+
+		result[ch].frequency = frequencies[ch];
+		result[ch].noise_floor = samples[n_samples / 2];
+		result[ch].peak = samples[n_samples - 1];
+
+		if ((result[ch].noise_floor < result[quietest].noise_floor) ||
+			((result[ch].noise_floor == result[quietest].noise_floor) && (result[ch].peak < result[quietest].peak)))
+		{
+			quietest = ch;
+		}
+	}
+
+	set_frequency(original_freq);
+
+	return quietest;
+}
+
 void LoRa::LLCC68::set_sleep(SleepConfig sleepConfig)
 {
 	wait_busy();
@@ -61,63 +334,706 @@ void LoRa::LLCC68::set_sleep(SleepConfig sleepConfig)
 	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_SLEEP));
 	_spi->transfer(*reinterpret_cast<uint8_t *>(&sleepConfig));
 	_spi->end_transfer();
+
+	/* Only part of the registers is retained, even in warm start */
+	invalidate_register_cache();
+	enter_state((sleepConfig.start_type == LLCC68_Constants::SleepConfig_StartType::WARM_START) ? RadioState::SLEEP_WARM : RadioState::SLEEP_COLD);
+}
+
+void LoRa::LLCC68::set_packet_type(LLCC68_Constants::PacketType protocol)
+{
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_PACKET_TYPE));
+	_spi->transfer(static_cast<uint8_t>(protocol));
+	_spi->end_transfer();
+
+	active_packet_type = protocol;
+}
+
+bool LoRa::LLCC68::switch_packet_type(LLCC68_Constants::PacketType packetType)
+{
+	if (packetType == active_packet_type)
+	{
+		return true;
+	}
+
+	if (parked_packet_params_size == 0)
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return false;
+	}
+
+	uint8_t packet_params[gfsk_packet_params_size];
+	const uint8_t packet_params_size = parked_packet_params_size;
+	std::memcpy(packet_params, parked_packet_params, packet_params_size);
+
+	/* Park the params of the modem being left */
+	std::memcpy(parked_packet_params, active_packet_params, active_packet_params_size);
+	parked_packet_params_size = active_packet_params_size;
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_packet_type(packetType);
+
+	if (packetType == LLCC68_Constants::PacketType::LORA)
+	{
+		write_command(lora_modulation_params, lora_modulation_params_size);
+	}
+	else
+	{
+		write_command(gfsk_modulation_params, gfsk_modulation_params_size);
+	}
+
+	std::memcpy(active_packet_params, packet_params, packet_params_size);
+	active_packet_params_size = packet_params_size;
+	write_command(active_packet_params, active_packet_params_size);
+
+	config.packet_type = packetType;
+
+	return true;
+}
+
+bool LoRa::LLCC68::is_valid_config(const LLCC68_config &config)
+{
+	using LoRa::LLCC68_Constants;
+
+	const auto &lora = config.modulation_params._lora;
+	const auto &gfsk = config.modulation_params._gfsk;
+
+	if ((config.rf_freq < 150000000) || (config.rf_freq > 960000000))
+	{
+		return false;
+	}
+	if ((config.tx_params.power_dbm < -9) || (config.tx_params.power_dbm > 22))
+	{
+		return false;
+	}
+
+	/* The inactive modem is only checked if it is configured, a zeroed LoRa SF or GFSK bitrate means it isn't */
+	const bool lora_configured = (config.packet_type == LLCC68_Constants::PacketType::LORA) || (static_cast<uint8_t>(lora.lora_sf) != 0);
+	const bool gfsk_configured = (config.packet_type == LLCC68_Constants::PacketType::GFSK) || (gfsk.bitrate != 0);
+
+	if (lora_configured)
+	{
+		/* LLCC68 reaches SF9 at 125kHz, SF10 at 250kHz and SF11 at 500kHz */
+		uint8_t max_sf = static_cast<uint8_t>(LLCC68_Constants::SF::SF9);
+		if (lora.bandwidth == LLCC68_Constants::BW::LORA_BW_250)
+		{
+			max_sf = static_cast<uint8_t>(LLCC68_Constants::SF::SF10);
+		}
+		else if (lora.bandwidth == LLCC68_Constants::BW::LORA_BW_500)
+		{
+			max_sf = static_cast<uint8_t>(LLCC68_Constants::SF::SF11);
+		}
+		else if (lora.bandwidth != LLCC68_Constants::BW::LORA_BW_125)
+		{
+			return false;
+		}
+		if ((static_cast<uint8_t>(lora.lora_sf) < static_cast<uint8_t>(LLCC68_Constants::SF::SF5)) || (static_cast<uint8_t>(lora.lora_sf) > max_sf))
+		{
+			return false;
+		}
+	}
+
+	if (gfsk_configured && ((gfsk.bitrate < 600) || (gfsk.bitrate > 300000) || (config.packet_params._gfsk.syncWordLength > 64)))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool LoRa::LLCC68::apply_config(const LLCC68_config &new_config)
+{
+	using LoRa::LLCC68_Constants;
+
+	if (!is_valid_config(new_config))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	/* TCXO changes need calibration, cold sleep lost every setting: both need init_llcc68 */
+	if ((new_config.use_TCXO != config.use_TCXO) || (new_config.tcxo_settings.tcxoVoltage != config.tcxo_settings.tcxoVoltage) ||
+		(new_config.tcxo_settings.delay != config.tcxo_settings.delay) || (radio_state == RadioState::SLEEP_COLD))
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return false;
+	}
+
+	const auto &lora_mod = new_config.modulation_params._lora;
+	const auto &gfsk_mod = new_config.modulation_params._gfsk;
+	const auto &lora_pkt = new_config.packet_params._lora;
+	const auto &gfsk_pkt = new_config.packet_params._gfsk;
+	const auto &old_lora_pkt = config.packet_params._lora;
+	const auto &old_gfsk_pkt = config.packet_params._gfsk;
+	const auto &settings = new_config.gfsk_settings;
+	const auto &old_settings = config.gfsk_settings;
+
+	/* Compare the commands rather than the structs, padding may differ */
+	uint8_t lora_mod_command[lora_modulation_params_size];
+	uint8_t gfsk_mod_command[gfsk_modulation_params_size] = {};
+	uint8_t lora_pkt_command[lora_packet_params_size];
+	uint8_t old_lora_pkt_command[lora_packet_params_size];
+	uint8_t gfsk_pkt_command[gfsk_packet_params_size];
+	uint8_t old_gfsk_pkt_command[gfsk_packet_params_size];
+
+	build_lora_modulation_params(lora_mod_command, lora_mod.lora_sf, lora_mod.bandwidth, lora_mod.code_rate, lora_mod.ldro);
+	if (gfsk_mod.bitrate != 0)
+	{
+		build_gfsk_modulation_params(gfsk_mod_command, gfsk_mod.bitrate, gfsk_mod.pulseShape, gfsk_mod.bandwidth, gfsk_mod.fdev);
+	}
+	build_lora_packet_params(lora_pkt_command, lora_pkt.preambleLength, lora_pkt.headerType, lora_pkt.payloadLength, lora_pkt.crcType, lora_pkt.invertIq);
+	build_lora_packet_params(old_lora_pkt_command, old_lora_pkt.preambleLength, old_lora_pkt.headerType, old_lora_pkt.payloadLength,
+							 old_lora_pkt.crcType, old_lora_pkt.invertIq);
+	build_gfsk_packet_params(gfsk_pkt_command, gfsk_pkt.preambleLength, gfsk_pkt.preambleDetectorLength, gfsk_pkt.syncWordLength,
+							 gfsk_pkt.addrComp, gfsk_pkt.packetType, gfsk_pkt.payloadLength, gfsk_pkt.crcType, gfsk_pkt.whitening);
+	build_gfsk_packet_params(old_gfsk_pkt_command, old_gfsk_pkt.preambleLength, old_gfsk_pkt.preambleDetectorLength, old_gfsk_pkt.syncWordLength,
+							 old_gfsk_pkt.addrComp, old_gfsk_pkt.packetType, old_gfsk_pkt.payloadLength, old_gfsk_pkt.crcType, old_gfsk_pkt.whitening);
+
+	const bool lora = (new_config.packet_type == LLCC68_Constants::PacketType::LORA);
+	const bool switch_type = (new_config.packet_type != active_packet_type);
+	const bool pa = (new_config.pa_config.paDutyCycle != config.pa_config.paDutyCycle) || (new_config.pa_config.hpMax != config.pa_config.hpMax);
+	const bool rf_switch = (new_config.use_DIO2_as_rf_switch_ctrl != config.use_DIO2_as_rf_switch_ctrl);
+	const bool frequency = (new_config.rf_freq != config.rf_freq);
+	/* PA config changes the meaning of the power setting, resend it */
+	const bool tx = pa || (new_config.tx_params.power_dbm != config.tx_params.power_dbm) || (new_config.tx_params.rampTime != config.tx_params.rampTime);
+	const bool lora_mod_changed = (std::memcmp(lora_mod_command, lora_modulation_params, lora_modulation_params_size) != 0);
+	const bool gfsk_mod_changed = (std::memcmp(gfsk_mod_command, gfsk_modulation_params, gfsk_modulation_params_size) != 0);
+	const bool lora_pkt_changed = (std::memcmp(lora_pkt_command, old_lora_pkt_command, lora_packet_params_size) != 0);
+	const bool gfsk_pkt_changed = (std::memcmp(gfsk_pkt_command, old_gfsk_pkt_command, gfsk_packet_params_size) != 0);
+	const bool modulation = switch_type || (lora ? lora_mod_changed : gfsk_mod_changed);
+	const bool packet = switch_type || (lora ? lora_pkt_changed : gfsk_pkt_changed);
+	const bool gfsk_registers = (gfsk_mod.bitrate != 0) &&
+								((config.modulation_params._gfsk.bitrate == 0) || (std::memcmp(settings.syncWord, old_settings.syncWord, sizeof(settings.syncWord)) != 0) ||
+								 (settings.whiteningSeed != old_settings.whiteningSeed) || (settings.crcInit != old_settings.crcInit) ||
+								 (settings.crcPoly != old_settings.crcPoly) || (settings.nodeAddress != old_settings.nodeAddress) ||
+								 (settings.broadcastAddress != old_settings.broadcastAddress));
+
+	if ((pa || rf_switch || switch_type || frequency || tx || modulation || packet || gfsk_registers) &&
+		(radio_state != RadioState::STDBY_RC) && (radio_state != RadioState::STDBY_XOSC))
+	{
+		set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	}
+
+	/* Same order as init_llcc68 */
+	if (pa)
+	{
+		set_pa_config(new_config.pa_config.paDutyCycle, new_config.pa_config.hpMax);
+	}
+	if (rf_switch)
+	{
+		set_dio2_as_rf_switch_ctrl(new_config.use_DIO2_as_rf_switch_ctrl);
+	}
+	if (switch_type)
+	{
+		set_packet_type(new_config.packet_type);
+	}
+	if (frequency)
+	{
+		set_rf_frequency(calculate_rf_frequency(new_config.rf_freq));
+	}
+	if (tx)
+	{
+		set_tx_params(new_config.tx_params.power_dbm, new_config.tx_params.rampTime);
+	}
+
+	std::memcpy(lora_modulation_params, lora_mod_command, lora_modulation_params_size);
+	std::memcpy(gfsk_modulation_params, gfsk_mod_command, gfsk_modulation_params_size);
+	if (modulation)
+	{
+		write_command(lora ? lora_modulation_params : gfsk_modulation_params, lora ? lora_modulation_params_size : gfsk_modulation_params_size);
+	}
+	if (packet)
+	{
+		std::memcpy(active_packet_params, lora ? lora_pkt_command : gfsk_pkt_command, lora ? lora_packet_params_size : gfsk_packet_params_size);
+		active_packet_params_size = lora ? lora_packet_params_size : gfsk_packet_params_size;
+		write_command(active_packet_params, active_packet_params_size);
+	}
+
+	config = new_config;
+
+	if (gfsk_registers)
+	{
+		write_gfsk_settings();
+	}
+
+	prepare_inactive_modem();
+	if (lora_pkt_changed)
+	{
+		rebuild_fixed_frames();
+	}
+	last_error = ErrorCode::NO_ERROR;
+
+	return true;
+}
+
+void LoRa::LLCC68::write_gfsk_settings()
+{
+	const auto &settings = config.gfsk_settings;
+	const uint8_t addresses[2] = {settings.nodeAddress, settings.broadcastAddress};
+
+	RegisterAccess accesses[16];
+	uint8_t n = 0;
+
+	/* One batch, so unchanged registers are skipped and neighbours share transactions */
+	accesses[n++] = RegisterAccess{REGISTER::WHITENING_INITIAL_MSB, 0x01, static_cast<uint8_t>(settings.whiteningSeed >> 8), nullptr};
+	accesses[n++] = write_byte(REGISTER::WHITENING_INITIAL_LSB, static_cast<uint8_t>(settings.whiteningSeed));
+	accesses[n++] = write_byte(REGISTER::CRC_INITIAL, static_cast<uint8_t>(settings.crcInit >> 8));
+	accesses[n++] = write_byte(REGISTER::CRC_INITIAL + 1, static_cast<uint8_t>(settings.crcInit));
+	accesses[n++] = write_byte(REGISTER::CRC_POLYNOMIAL, static_cast<uint8_t>(settings.crcPoly >> 8));
+	accesses[n++] = write_byte(REGISTER::CRC_POLYNOMIAL + 1, static_cast<uint8_t>(settings.crcPoly));
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		accesses[n++] = write_byte(REGISTER::SYNC_WORD + i, settings.syncWord[i]);
+	}
+	accesses[n++] = write_byte(REGISTER::NODE_ADDRESS, addresses[0]);
+	accesses[n++] = write_byte(REGISTER::BROADCAST_ADDRESS, addresses[1]);
+
+	access_registers(accesses, n);
+}
+
+void LoRa::LLCC68::rebuild_fixed_frames()
+{
+	for (uint8_t i = 0; i < max_fixed_frames; i++)
+	{
+		if (fixed_frames[i].length != 0)
+		{
+			register_fixed_frame(i, fixed_frames[i].length);
+		}
+	}
+}
+
+void LoRa::LLCC68::build_lora_modulation_params(uint8_t *command, LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldOpt)
+{
+	command[0] = static_cast<uint8_t>(OPCODE::SET_MODULATION_PARAMS);
+	command[1] = static_cast<uint8_t>(sf);
+	command[2] = static_cast<uint8_t>(bw);
+	command[3] = static_cast<uint8_t>(cr);
+	command[4] = static_cast<uint8_t>(ldOpt);
+}
+
+void LoRa::LLCC68::build_gfsk_modulation_params(uint8_t *command, uint32_t bitrate, LLCC68_Constants::PulseShape pulseShape, LLCC68_Constants::GFSK_BW bandwidth, uint32_t fdev)
+{
+	/* BR = 32 * F_XTAL / bitrate, Fdev = fdev * 2^25 / F_XTAL */
+	const uint32_t br = static_cast<uint32_t>((32ULL * 32000000ULL) / bitrate);
+	const uint32_t fd = static_cast<uint32_t>((static_cast<uint64_t>(fdev) << 25) / 32000000ULL);
+
+	command[0] = static_cast<uint8_t>(OPCODE::SET_MODULATION_PARAMS);
+	command[1] = static_cast<uint8_t>((br & 0x00FF0000) >> 16);
+	command[2] = static_cast<uint8_t>((br & 0x0000FF00) >> 8);
+	command[3] = static_cast<uint8_t>(br & 0x000000FF);
+	command[4] = static_cast<uint8_t>(pulseShape);
+	command[5] = static_cast<uint8_t>(bandwidth);
+	command[6] = static_cast<uint8_t>((fd & 0x00FF0000) >> 16);
+	command[7] = static_cast<uint8_t>((fd & 0x0000FF00) >> 8);
+	command[8] = static_cast<uint8_t>(fd & 0x000000FF);
+}
+
+void LoRa::LLCC68::build_lora_packet_params(uint8_t *command, uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, uint8_t payloadLength,
+											LLCC68_Constants::CRC_Type crcType, LLCC68_Constants::InvertIQ invertIq)
+{
+	command[0] = static_cast<uint8_t>(OPCODE::SET_PACKET_PARAMS);
+	command[1] = static_cast<uint8_t>((preambleLength & 0xFF00) >> 8);
+	command[2] = static_cast<uint8_t>(preambleLength & 0x00FF);
+	command[3] = static_cast<uint8_t>(headerType);
+	command[4] = payloadLength;
+	command[5] = static_cast<uint8_t>(crcType);
+	command[6] = static_cast<uint8_t>(invertIq);
+}
+
+void LoRa::LLCC68::build_gfsk_packet_params(uint8_t *command, uint16_t preambleLength, LLCC68_Constants::PreambleDetector preambleDetectorLength, uint8_t syncWordLength,
+											LLCC68_Constants::AddrComp addrComp, LLCC68_Constants::GFSK_PacketType packetType, uint8_t payloadLength,
+											LLCC68_Constants::GFSK_CRC_Type crcType, LLCC68_Constants::Whitening whitening)
+{
+	command[0] = static_cast<uint8_t>(OPCODE::SET_PACKET_PARAMS);
+	command[1] = static_cast<uint8_t>((preambleLength & 0xFF00) >> 8);
+	command[2] = static_cast<uint8_t>(preambleLength & 0x00FF);
+	command[3] = static_cast<uint8_t>(preambleDetectorLength);
+	command[4] = syncWordLength;
+	command[5] = static_cast<uint8_t>(addrComp);
+	command[6] = static_cast<uint8_t>(packetType);
+	command[7] = payloadLength;
+	command[8] = static_cast<uint8_t>(crcType);
+	command[9] = static_cast<uint8_t>(whitening);
+}
+
+void LoRa::LLCC68::set_lora_modulation_params(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldOpt)
+{
+	build_lora_modulation_params(lora_modulation_params, sf, bw, cr, ldOpt);
+	write_command(lora_modulation_params, lora_modulation_params_size);
+}
+
+void LoRa::LLCC68::set_gfsk_modulation_params(uint32_t bitrate, LLCC68_Constants::PulseShape pulseShape, LLCC68_Constants::GFSK_BW bandwidth, uint32_t fdev)
+{
+	if ((bitrate < 600) || (bitrate > 300000))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return;
+	}
+
+	build_gfsk_modulation_params(gfsk_modulation_params, bitrate, pulseShape, bandwidth, fdev);
+	write_command(gfsk_modulation_params, gfsk_modulation_params_size);
+}
+
+void LoRa::LLCC68::prepare_inactive_modem()
+{
+	if (active_packet_type == LLCC68_Constants::PacketType::LORA)
+	{
+		const auto &modulation = config.modulation_params._gfsk;
+		const auto &packet = config.packet_params._gfsk;
+
+		if (modulation.bitrate == 0)
+		{
+			parked_packet_params_size = 0;
+			return;
+		}
+
+		build_gfsk_modulation_params(gfsk_modulation_params, modulation.bitrate, modulation.pulseShape, modulation.bandwidth, modulation.fdev);
+		build_gfsk_packet_params(parked_packet_params, packet.preambleLength, packet.preambleDetectorLength, packet.syncWordLength,
+								 packet.addrComp, packet.packetType, packet.payloadLength, packet.crcType, packet.whitening);
+		parked_packet_params_size = gfsk_packet_params_size;
+	}
+	else
+	{
+		const auto &modulation = config.modulation_params._lora;
+		const auto &packet = config.packet_params._lora;
+
+		if (static_cast<uint8_t>(modulation.lora_sf) == 0)
+		{
+			parked_packet_params_size = 0;
+			return;
+		}
+
+		build_lora_modulation_params(lora_modulation_params, modulation.lora_sf, modulation.bandwidth, modulation.code_rate, modulation.ldro);
+		build_lora_packet_params(parked_packet_params, packet.preambleLength, packet.headerType, packet.payloadLength, packet.crcType, packet.invertIq);
+		parked_packet_params_size = lora_packet_params_size;
+	}
+}
+
+void LoRa::LLCC68::set_crc_poly(uint16_t crc16)
+{
+	const RegisterAccess accesses[2] = {write_byte(REGISTER::CRC_POLYNOMIAL, static_cast<uint8_t>(crc16 >> 8)),
+										write_byte(REGISTER::CRC_POLYNOMIAL + 1, static_cast<uint8_t>(crc16))};
+	access_registers(accesses, 2);
+}
+
+void LoRa::LLCC68::set_crc_init(uint16_t crc16)
+{
+	const RegisterAccess accesses[2] = {write_byte(REGISTER::CRC_INITIAL, static_cast<uint8_t>(crc16 >> 8)),
+										write_byte(REGISTER::CRC_INITIAL + 1, static_cast<uint8_t>(crc16))};
+	access_registers(accesses, 2);
+}
+
+void LoRa::LLCC68::set_sync_word(const uint8_t *sync_word, uint8_t n)
+{
+	RegisterAccess accesses[8];
+
+	if (n > sizeof(accesses) / sizeof(accesses[0]))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return;
+	}
+
+	/* Unused bytes are zeroed */
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		accesses[i] = write_byte(REGISTER::SYNC_WORD + i, (i < n) ? sync_word[i] : 0);
+	}
+	access_registers(accesses, 8);
+}
+
+void LoRa::LLCC68::set_whitening_seed(uint16_t seed)
+{
+	/* Upper bits of the MSB register are reserved, keep them */
+	const RegisterAccess accesses[2] = {RegisterAccess{REGISTER::WHITENING_INITIAL_MSB, 0x01, static_cast<uint8_t>(seed >> 8), nullptr},
+										write_byte(REGISTER::WHITENING_INITIAL_LSB, static_cast<uint8_t>(seed))};
+	access_registers(accesses, 2);
+}
+
+bool LoRa::LLCC68::access_registers(const RegisterAccess *accesses, uint8_t count)
+{
+	typedef struct
+	{
+		uint16_t address;
+		uint8_t value;
+		bool known; /* Cached or read */
+		bool read;	/* The first access needs the device value */
+		bool dirty;
+
+	} Slot;
+
+	if (count > max_register_accesses)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	/* Distinct addresses in ascending order */
+	Slot slots[max_register_accesses];
+	uint8_t n = 0;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		const uint16_t address = accesses[i].address;
+		uint8_t k = 0;
+
+		while ((k < n) && (slots[k].address < address))
+		{
+			k++;
+		}
+		if ((k < n) && (slots[k].address == address))
+		{
+			continue;
+		}
+
+		const CachedRegister *cached = find_cached_register(address);
+		std::memmove(slots + k + 1, slots + k, (n - k) * sizeof(Slot));
+		slots[k] = Slot{address, (cached != nullptr) ? cached->value : uint8_t{0}, cached != nullptr, (cached == nullptr) && (accesses[i].mask != 0xFF), false};
+		n++;
+	}
+
+	auto known_value = [&](uint16_t address, uint8_t *value) -> bool
+	{
+		for (uint8_t k = 0; k < n; k++)
+		{
+			if (slots[k].address == address)
+			{
+				*value = slots[k].value;
+				return slots[k].known;
+			}
+		}
+
+		const CachedRegister *cached = find_cached_register(address);
+		if (cached != nullptr)
+		{
+			*value = cached->value;
+		}
+
+		return cached != nullptr;
+	};
+
+	uint8_t burst[max_register_accesses * (register_merge_gap + 1)];
+
+	/* Reads for read-modify-writes and reads of unknown registers, close ones in one burst */
+	for (uint8_t first = 0; first < n; first++)
+	{
+		if (!slots[first].read)
+		{
+			continue;
+		}
+
+		uint8_t last = first;
+		for (uint8_t k = first + 1; (k < n) && (slots[k].address - slots[last].address <= register_merge_gap + 1); k++)
+		{
+			if (slots[k].read)
+			{
+				last = k;
+			}
+		}
+
+		const uint16_t base = slots[first].address;
+		read_register(base, burst, static_cast<uint8_t>(slots[last].address - base + 1));
+		for (uint8_t k = first; k <= last; k++)
+		{
+			slots[k].value = burst[slots[k].address - base];
+			slots[k].known = true;
+			slots[k].read = false;
+		}
+		first = last;
+	}
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		Slot *slot = slots;
+		while (slot->address != accesses[i].address)
+		{
+			slot++;
+		}
+
+		const uint8_t value = static_cast<uint8_t>((slot->value & ~accesses[i].mask) | (accesses[i].value & accesses[i].mask));
+
+		slot->dirty = slot->dirty || !slot->known || (value != slot->value);
+		slot->value = value;
+		slot->known = true;
+		if (accesses[i].result != nullptr)
+		{
+			*accesses[i].result = value;
+		}
+	}
+
+	/* Writes of changed registers, close ones in one burst if every byte in between is known */
+	for (uint8_t first = 0; first < n; first++)
+	{
+		if (!slots[first].dirty)
+		{
+			continue;
+		}
+
+		uint8_t last = first;
+		for (uint8_t k = first + 1; (k < n) && (slots[k].address - slots[last].address <= register_merge_gap + 1); k++)
+		{
+			if (!slots[k].dirty)
+			{
+				continue;
+			}
+
+			bool bridged = true;
+			for (uint16_t address = slots[last].address + 1; bridged && (address < slots[k].address); address++)
+			{
+				uint8_t value;
+				bridged = known_value(address, &value);
+			}
+			if (!bridged)
+			{
+				break;
+			}
+			last = k;
+		}
+
+		const uint16_t base = slots[first].address;
+		const uint8_t span = static_cast<uint8_t>(slots[last].address - base + 1);
+		for (uint8_t k = 0; k < span; k++)
+		{
+			known_value(base + k, &burst[k]);
+		}
+		write_register(base, burst, span);
+		first = last;
+	}
+
+	for (uint8_t k = 0; k < n; k++)
+	{
+		cache_register(slots[k].address, slots[k].value);
+	}
+	last_error = ErrorCode::NO_ERROR;
+
+	return true;
+}
+
+void LoRa::LLCC68::invalidate_register_cache()
+{
+	n_cached_registers = 0;
+	next_evicted_register = 0;
+}
+
+LoRa::LLCC68::CachedRegister *LoRa::LLCC68::find_cached_register(uint16_t address)
+{
+	for (uint8_t i = 0; i < n_cached_registers; i++)
+	{
+		if (register_cache[i].address == address)
+		{
+			return &register_cache[i];
+		}
+	}
+
+	return nullptr;
+}
+
+void LoRa::LLCC68::cache_register(uint16_t address, uint8_t value)
+{
+	CachedRegister *cached = find_cached_register(address);
+
+	if (cached == nullptr)
+	{
+		if (n_cached_registers < register_cache_size)
+		{
+			cached = &register_cache[n_cached_registers++];
+		}
+		else
+		{
+			cached = &register_cache[next_evicted_register];
+			next_evicted_register = static_cast<uint8_t>((next_evicted_register + 1) % register_cache_size);
+		}
+		cached->address = address;
+	}
+	cached->value = value;
+}
+
+void LoRa::LLCC68::set_tx(int32_t timeout)
+{
+	wait_busy();
+
+	dio1_edge_latched = false; // Edges before the operation starts are stale
+
+	timeout = timeout & 0x00FFFFFF;
+
+	_spi->begin_transfer();
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_TX));
+	_spi->transfer(static_cast<uint8_t>((timeout & 0x00FF0000) >> 16));
+	_spi->transfer(static_cast<uint8_t>((timeout & 0x0000FF00) >> 8));
+	_spi->transfer(static_cast<uint8_t>(timeout & 0x000000FF));
+	_spi->end_transfer();
+
+	enter_state(RadioState::TX);
 }
 
-void LoRa::LLCC68::set_packet_type(LLCC68_Constants::PacketType protocol)
+void LoRa::LLCC68::set_rx(int32_t timeout)
 {
-	if (protocol != LLCC68_Constants::PacketType::LORA)
-	{
-		// GFSK is not supported yet, and exceptions are not enabled
-		return;
-	}
-
 	wait_busy();
 
+	dio1_edge_latched = false; // Edges before the operation starts are stale
+
+	timeout = timeout & 0x00FFFFFF;
+
 	_spi->begin_transfer();
-	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_PACKET_TYPE));
-	_spi->transfer(static_cast<uint8_t>(protocol));
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_RX));
+	_spi->transfer(static_cast<uint8_t>((timeout & 0x00FF0000) >> 16));
+	_spi->transfer(static_cast<uint8_t>((timeout & 0x0000FF00) >> 8));
+	_spi->transfer(static_cast<uint8_t>(timeout & 0x000000FF));
 	_spi->end_transfer();
+
+	rx_continuous = (timeout == 0x00FFFFFF);
+	enter_state(RadioState::RX);
 }
 
-void LoRa::LLCC68::set_lora_modulation_params(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldOpt)
+void LoRa::LLCC68::set_stop_timer_on_preamble(LLCC68_Constants::Enable enable)
 {
 	wait_busy();
 
 	_spi->begin_transfer();
-	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_MODULATION_PARAMS));
-	_spi->transfer(static_cast<uint8_t>(sf));
-	_spi->transfer(static_cast<uint8_t>(bw));
-	_spi->transfer(static_cast<uint8_t>(cr));
-	_spi->transfer(static_cast<uint8_t>(ldOpt));
+	_spi->transfer(static_cast<uint8_t>(OPCODE::STOP_TIMER_ON_PREAMBLE));
+	_spi->transfer(static_cast<uint8_t>(enable));
 	_spi->end_transfer();
 }
 
-void LoRa::LLCC68::set_tx(int32_t timeout)
+void LoRa::LLCC68::set_lora_symb_num_timeout(uint8_t symbNum)
 {
 	wait_busy();
 
-	timeout = timeout & 0x00FFFFFF;
-
 	_spi->begin_transfer();
-	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_TX));
-	_spi->transfer(static_cast<uint8_t>((timeout & 0x00FF0000) >> 16));
-	_spi->transfer(static_cast<uint8_t>((timeout & 0x0000FF00) >> 8));
-	_spi->transfer(static_cast<uint8_t>(timeout & 0x000000FF));
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_LORA_SYMB_NUM_TIMEOUT));
+	_spi->transfer(symbNum);
 	_spi->end_transfer();
 }
 
-void LoRa::LLCC68::set_rx(int32_t timeout)
+void LoRa::LLCC68::set_cad_params(LLCC68_Constants::CadSymbolNum symbolNum, uint8_t detPeak, uint8_t detMin, LLCC68_Constants::CadExitMode exitMode, uint32_t timeout)
+{
+	const uint8_t command[] = {
+		static_cast<uint8_t>(OPCODE::SET_CAD_PARAMS),
+		static_cast<uint8_t>(symbolNum),
+		detPeak,
+		detMin,
+		static_cast<uint8_t>(exitMode),
+		static_cast<uint8_t>((timeout >> 16) & 0xFF),
+		static_cast<uint8_t>((timeout >> 8) & 0xFF),
+		static_cast<uint8_t>(timeout & 0xFF),
+	};
+
+	write_command(command, sizeof(command));
+}
+
+void LoRa::LLCC68::set_cad()
 {
 	wait_busy();
 
-	timeout = timeout & 0x00FFFFFF;
+	dio1_edge_latched = false;
 
 	_spi->begin_transfer();
-	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_RX));
-	_spi->transfer(static_cast<uint8_t>((timeout & 0x00FF0000) >> 16));
-	_spi->transfer(static_cast<uint8_t>((timeout & 0x0000FF00) >> 8));
-	_spi->transfer(static_cast<uint8_t>(timeout & 0x000000FF));
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_CAD));
 	_spi->end_transfer();
+
+	enter_state(RadioState::CAD);
 }
 
 void LoRa::LLCC68::set_regulator_mode(
@@ -200,22 +1116,117 @@ void LoRa::LLCC68::set_tx_params(int8_t power_dbm,
 	_spi->transfer(power_dbm);
 	_spi->transfer(static_cast<uint8_t>(rampTime));
 	_spi->end_transfer();
+
+	tx_power_dbm = power_dbm;
 }
 
 void LoRa::LLCC68::set_lora_packet_params(
 	uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, uint8_t payloadLength, LLCC68_Constants::CRC_Type crcType, LLCC68_Constants::InvertIQ invertIq)
 {
-	wait_busy();
+	build_lora_packet_params(active_packet_params, preambleLength, headerType, payloadLength, crcType, invertIq);
+	active_packet_params_size = lora_packet_params_size;
 
-	_spi->begin_transfer();
-	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_PACKET_PARAMS));
-	_spi->transfer(static_cast<uint8_t>((preambleLength & 0xFF00) >> 8));
-	_spi->transfer(static_cast<uint8_t>(preambleLength & 0x00FF));
-	_spi->transfer(static_cast<uint8_t>(headerType));
-	_spi->transfer(payloadLength);
-	_spi->transfer(static_cast<uint8_t>(crcType));
-	_spi->transfer(static_cast<uint8_t>(invertIq));
-	_spi->end_transfer();
+	write_command(active_packet_params, active_packet_params_size);
+}
+
+void LoRa::LLCC68::set_gfsk_packet_params(uint16_t preambleLength, LLCC68_Constants::PreambleDetector preambleDetectorLength, uint8_t syncWordLength,
+										  LLCC68_Constants::AddrComp addrComp, LLCC68_Constants::GFSK_PacketType packetType, uint8_t payloadLength,
+										  LLCC68_Constants::GFSK_CRC_Type crcType, LLCC68_Constants::Whitening whitening)
+{
+	if (syncWordLength > 64)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return;
+	}
+
+	build_gfsk_packet_params(active_packet_params, preambleLength, preambleDetectorLength, syncWordLength,
+							 addrComp, packetType, payloadLength, crcType, whitening);
+	active_packet_params_size = gfsk_packet_params_size;
+
+	write_command(active_packet_params, active_packet_params_size);
+}
+
+void LoRa::LLCC68::set_payload_length(uint8_t payloadLength)
+{
+	const uint8_t index = (active_packet_type == LLCC68_Constants::PacketType::LORA) ? 4 : 7;
+
+	if (active_packet_params[index] == payloadLength)
+	{
+		return;
+	}
+
+	active_packet_params[index] = payloadLength;
+	write_command(active_packet_params, active_packet_params_size);
+}
+
+bool LoRa::LLCC68::register_fixed_frame(uint8_t frame_class, uint8_t length)
+{
+	if ((frame_class >= max_fixed_frames) || (length == 0))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	const auto &lora = config.packet_params._lora;
+	FixedFrame &frame = fixed_frames[frame_class];
+
+	frame.length = length;
+	build_lora_packet_params(frame.packet_params, lora.preambleLength, LLCC68_Constants::HeaderType::IMPLICIT_HEADER,
+							 length, lora.crcType, lora.invertIq);
+
+	return true;
+}
+
+bool LoRa::LLCC68::select_fixed_frame(uint8_t frame_class)
+{
+	if ((frame_class >= max_fixed_frames) || (fixed_frames[frame_class].length == 0))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	if (active_packet_type != LLCC68_Constants::PacketType::LORA)
+	{
+		/* Implicit header is a LoRa feature */
+		last_error = ErrorCode::UNSUPPORTED;
+		return false;
+	}
+
+	const FixedFrame &frame = fixed_frames[frame_class];
+
+	if (std::memcmp(active_packet_params, frame.packet_params, lora_packet_params_size) != 0)
+	{
+		std::memcpy(active_packet_params, frame.packet_params, lora_packet_params_size);
+		active_packet_params_size = lora_packet_params_size;
+		write_command(active_packet_params, active_packet_params_size);
+	}
+
+	return true;
+}
+
+void LoRa::LLCC68::select_variable_frame()
+{
+	if (active_packet_type != LLCC68_Constants::PacketType::LORA)
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return;
+	}
+
+	set_lora_packet_params(config.packet_params._lora.preambleLength,
+						   config.packet_params._lora.headerType,
+						   config.packet_params._lora.payloadLength,
+						   config.packet_params._lora.crcType,
+						   config.packet_params._lora.invertIq);
+}
+
+void LoRa::LLCC68::send_fixed_frame(uint8_t frame_class, const uint8_t *frame)
+{
+	if (!select_fixed_frame(frame_class))
+	{
+		return;
+	}
+
+	send_packet(frame, fixed_frames[frame_class].length);
 }
 
 void LoRa::LLCC68::set_buffer_base_address(uint8_t tx_base_addr,
@@ -230,23 +1241,269 @@ void LoRa::LLCC68::set_buffer_base_address(uint8_t tx_base_addr,
 	_spi->end_transfer();
 }
 
-void LoRa::LLCC68::wait_for_irq_tx_done(int dio_pin)
+void LoRa::LLCC68::get_rx_buffer_status(uint8_t *payloadLength, uint8_t *rxStartBufferPointer)
 {
-	using LoRa::LLCC68_Constants;
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(static_cast<uint8_t>(OPCODE::GET_RX_BUFFER_STATUS));
+	_spi->transfer(static_cast<uint8_t>(OPCODE::NOP));
+	*payloadLength = _spi->transfer(static_cast<uint8_t>(OPCODE::NOP));
+	*rxStartBufferPointer = _spi->transfer(static_cast<uint8_t>(OPCODE::NOP));
+	_spi->end_transfer();
+}
 
-	uint8_t n_timeout = 0;
+void LoRa::LLCC68::write_command(const uint8_t *command, uint8_t n)
+{
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(command, n);
+	_spi->end_transfer();
+}
 
-	while (!_io->read(dio_pin)) // TODO: Check datasheet
+bool LoRa::LLCC68::is_irq_pending()
+{
+	if (_io->read(pins.dio1) == 0)
 	{
-		// IRQ mask should be checked for tx done flag
-		n_timeout++;
-		_device->delay(1);
-		if (n_timeout > 200)
+		return false;
+	}
+
+	irq_time_us = take_dio1_edge();
+
+	return true;
+}
+
+void LoRa::LLCC68::on_dio1_edge()
+{
+	dio1_edge_us = _device->timestamp_us();
+	dio1_edge_latched = true;
+}
+
+int64_t LoRa::LLCC68::take_dio1_edge()
+{
+	if (dio1_edge_latched)
+	{
+		dio1_edge_latched = false;
+		return dio1_edge_us;
+	}
+
+	return _device->timestamp_us();
+}
+
+void LoRa::LLCC68::stamp_packet(PacketTime &time, uint8_t payloadLength)
+{
+	if (irq_time_us == 0)
+	{
+		time = PacketTime{};
+		return;
+	}
+
+	time.end_us = irq_time_us;
+	time.start_us = irq_time_us - get_time_on_air(payloadLength);
+
+	if (&time == &tx_time)
+	{
+		energy.tx_packets++;
+		energy.tx_bytes += payloadLength;
+	}
+	else
+	{
+		energy.rx_packets++;
+		energy.rx_bytes += payloadLength;
+	}
+}
+
+void LoRa::LLCC68::capture_tx(const Segment *segments, uint8_t count)
+{
+	/* Unstamped: TxDone was never seen, the frame may not have gone out whole */
+	if ((capture_sink == nullptr) || (tx_time.end_us == 0))
+	{
+		return;
+	}
+
+	uint8_t payload[255];
+	uint8_t size = 0;
+
+	if (segments == nullptr)
+	{
+		/* TX base address is 0, see init_llcc68 */
+		size = get_payload_length();
+		read_buffer(payload, size, 0);
+	}
+	else
+	{
+		for (uint8_t i = 0; i < count; i++)
+		{
+			std::memcpy(payload + size, segments[i].data, segments[i].size);
+			size = static_cast<uint8_t>(size + segments[i].size);
+		}
+	}
+
+	const auto &lora = config.modulation_params._lora;
+	const CapturedFrame frame{tx_time.start_us, config.rf_freq, active_packet_type,
+							  lora.lora_sf, lora.bandwidth, lora.code_rate, PacketStatus{}, true, true, payload, size};
+
+	capture_sink->capture(frame);
+}
+
+void LoRa::LLCC68::capture_rx(const uint8_t *payload, uint8_t size, bool crc_ok)
+{
+	if (capture_sink == nullptr)
+	{
+		return;
+	}
+
+	uint8_t buffer[255];
+	int64_t start_us = rx_time.start_us;
+
+	if (payload == nullptr)
+	{
+		uint8_t start = 0;
+
+		get_rx_buffer_status(&size, &start);
+		read_buffer(buffer, size, start);
+		payload = buffer;
+		if (!crc_ok)
+		{
+			/* Not stamped, the frame isn't counted as received */
+			start_us = irq_time_us - get_time_on_air(size);
+		}
+	}
+
+	const auto &lora = config.modulation_params._lora;
+	const CapturedFrame frame{(start_us > 0) ? start_us : _device->timestamp_us(), config.rf_freq, active_packet_type,
+							  lora.lora_sf, lora.bandwidth, lora.code_rate, get_packet_status(), false, crc_ok, payload, size};
+
+	capture_sink->capture(frame);
+}
+
+void LoRa::LLCC68::enter_state(RadioState state, int64_t at_us)
+{
+	if (at_us < 0)
+	{
+		at_us = _device->timestamp_us();
+	}
+
+	/* Nothing to book before the first transition */
+	if ((state_since_us >= 0) && (at_us > state_since_us))
+	{
+		const uint8_t i = static_cast<uint8_t>(radio_state);
+		const int64_t elapsed = at_us - state_since_us;
+
+		energy.residency_us[i] += elapsed;
+		/* nA * us = 1e-15 C, uAh = 3.6e-3 C */
+		energy.charge_uah[i] += static_cast<double>(get_state_current(radio_state)) * static_cast<double>(elapsed) / 3.6e12;
+	}
+
+	if ((state_since_us < 0) || (at_us > state_since_us))
+	{
+		state_since_us = at_us;
+	}
+	radio_state = state;
+}
+
+uint32_t LoRa::LLCC68::get_state_current(RadioState state) const
+{
+	switch (state)
+	{
+	case RadioState::SLEEP_COLD:
+		return current_table.sleep_cold_na;
+	case RadioState::SLEEP_WARM:
+		return current_table.sleep_warm_na;
+	case RadioState::STDBY_XOSC:
+		return current_table.standby_xosc_na;
+	case RadioState::RX:
+		return current_table.rx_na;
+	case RadioState::CAD:
+		return current_table.cad_na;
+	case RadioState::TX:
+		break;
+	default:
+		return current_table.standby_rc_na;
+	}
+
+	const TxCurrent *tx = current_table.tx;
+	const uint8_t n = current_table.n_tx_points;
+
+	if (n == 0)
+	{
+		return 0;
+	}
+	if (tx_power_dbm <= tx[0].power_dbm)
+	{
+		return tx[0].current_na;
+	}
+
+	for (uint8_t i = 1; i < n; i++)
+	{
+		if (tx_power_dbm <= tx[i].power_dbm)
+		{
+			const int64_t span = tx[i].power_dbm - tx[i - 1].power_dbm;
+			const int64_t delta = static_cast<int64_t>(tx[i].current_na) - tx[i - 1].current_na;
+
+			return static_cast<uint32_t>(tx[i - 1].current_na + (delta * (tx_power_dbm - tx[i - 1].power_dbm)) / span);
+		}
+	}
+
+	return tx[n - 1].current_na;
+}
+
+const LoRa::EnergyLedger &LoRa::LLCC68::get_energy_ledger()
+{
+	enter_state(radio_state);
+
+	return energy;
+}
+
+double LoRa::LLCC68::get_consumed_mah()
+{
+	const EnergyLedger &ledger = get_energy_ledger();
+	double total = 0.0;
+
+	for (uint8_t i = 0; i < n_radio_states; i++)
+	{
+		total += ledger.charge_uah[i];
+	}
+
+	return total / 1000.0;
+}
+
+void LoRa::LLCC68::reset_energy_ledger()
+{
+	enter_state(radio_state);
+	energy = EnergyLedger{};
+}
+
+void LoRa::LLCC68::set_current_table(const CurrentTable &table)
+{
+	enter_state(radio_state);
+	current_table = table;
+}
+
+void LoRa::LLCC68::cancel()
+{
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+}
+
+bool LoRa::LLCC68::wait_for_irq(int dio_pin, int32_t timeout_ms)
+{
+	const int32_t ts = _device->timestamp();
+
+	while (!_io->read(dio_pin))
+	{
+		if ((_device->timestamp() - ts) > timeout_ms)
 		{
 			last_error = ErrorCode::TIMED_OUT;
-			return;
+			return false;
 		}
+		_device->delay(1);
 	}
+
+	irq_time_us = take_dio1_edge();
+
+	return true;
 }
 
 void LoRa::LLCC68::wait_busy(int32_t timeout)
@@ -283,13 +1540,21 @@ bool LoRa::LLCC68::is_busy()
 	return (v >= (n / 2)) ? true : false;
 }
 
-void LoRa::LLCC68::write_register(uint16_t address, uint8_t *data, uint8_t n)
+void LoRa::LLCC68::write_register(uint16_t address, const uint8_t *data, uint8_t n)
 {
 	if (n == 0)
 	{
 		return;
 	}
 
+	for (uint8_t i = 0; i < n_cached_registers; i++)
+	{
+		if ((register_cache[i].address >= address) && (register_cache[i].address - address < n))
+		{
+			register_cache[i].value = data[register_cache[i].address - address];
+		}
+	}
+
 	wait_busy();
 
 	_spi->begin_transfer();
@@ -314,11 +1579,17 @@ void LoRa::LLCC68::read_register(uint16_t address, uint8_t *buffer, uint8_t n)
 	_spi->transfer(static_cast<uint8_t>((address & 0xFF00) >> 8));
 	_spi->transfer(static_cast<uint8_t>((address & 0x00FF)));
 	_spi->transfer(static_cast<uint8_t>(OPCODE::NOP)); /* Now the next transfer will retrieve the first data */
-	while (n--)
+	std::memset(buffer, static_cast<uint8_t>(OPCODE::NOP), n);
+	_spi->transfer(buffer, n);
+	_spi->end_transfer();
+
+	for (uint8_t i = 0; i < n_cached_registers; i++)
 	{
-		*buffer++ = _spi->transfer(static_cast<uint8_t>(OPCODE::NOP));
+		if ((register_cache[i].address >= address) && (register_cache[i].address - address < n))
+		{
+			register_cache[i].value = buffer[register_cache[i].address - address];
+		}
 	}
-	_spi->end_transfer();
 }
 
 void LoRa::LLCC68::write_buffer(const uint8_t *data, uint8_t n, uint8_t offset)
@@ -337,6 +1608,28 @@ void LoRa::LLCC68::write_buffer(const uint8_t *data, uint8_t n, uint8_t offset)
 	_spi->end_transfer();
 }
 
+void LoRa::LLCC68::write_buffer(const Segment *segments, uint8_t count, uint8_t offset)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	wait_busy();
+
+	_spi->begin_transfer();
+	_spi->transfer(static_cast<uint8_t>(OPCODE::WRITE_BUFFER));
+	_spi->transfer(offset);
+	for (uint8_t i = 0; i < count; i++)
+	{
+		if (segments[i].size > 0)
+		{
+			_spi->transfer(segments[i].data, segments[i].size);
+		}
+	}
+	_spi->end_transfer();
+}
+
 void LoRa::LLCC68::read_buffer(uint8_t *buffer, uint8_t n, uint8_t offset)
 {
 	if (n == 0)
@@ -368,6 +1661,7 @@ void LoRa::LLCC68::set_dio_irq_params(IrqMask irqMask, IrqMask dio1_mask,
 	wait_busy();
 
 	_spi->begin_transfer();
+	_spi->transfer(static_cast<uint8_t>(OPCODE::SET_DIO_IRQ_PARAMS));
 	_spi->transfer(static_cast<uint8_t>((_irqMask & 0xFF00) >> 8));
 	_spi->transfer(static_cast<uint8_t>((_irqMask & 0x00FF)));
 	_spi->transfer(static_cast<uint8_t>((_dio1_mask & 0xFF00) >> 8));
@@ -409,4 +1703,17 @@ void LoRa::LLCC68::clear_irq_status(LLCC68_Constants::ClearIrqParam clearIrqPara
 	_spi->transfer(static_cast<uint8_t>((_clearIrqParam & 0xFF00) >> 8));
 	_spi->transfer(static_cast<uint8_t>((_clearIrqParam & 0x00FF)));
 	_spi->end_transfer();
+
+	/* The device returned to STDBY_RC on its own when the operation ended */
+	constexpr uint16_t terminal = static_cast<uint16_t>(LLCC68_Constants::ClearIrqParam::TxDone) |
+								  static_cast<uint16_t>(LLCC68_Constants::ClearIrqParam::RxDone) |
+								  static_cast<uint16_t>(LLCC68_Constants::ClearIrqParam::CadDone) |
+								  static_cast<uint16_t>(LLCC68_Constants::ClearIrqParam::Timeout);
+	const bool operation_ended = (radio_state == RadioState::TX) || (radio_state == RadioState::CAD) ||
+								 ((radio_state == RadioState::RX) && !rx_continuous);
+
+	if (((_clearIrqParam & terminal) != 0) && operation_ended)
+	{
+		enter_state(RadioState::STDBY_RC, (irq_time_us >= state_since_us) ? irq_time_us : -1);
+	}
 }
@@ -20,18 +20,367 @@
 
 namespace LoRa
 {
+	/* One piece of a packet, see scatter-gather send_packet */
+	typedef struct
+	{
+		const uint8_t *data;
+		uint8_t size;
+
+	} Segment;
+
+	/**
+	 * @brief One step of a register batch, see LLCC68::access_registers. Bits set in mask are
+	 * replaced by value, the others keep their current value: 0xFF writes, 0x00 only reads.
+	 */
+	typedef struct
+	{
+		uint16_t address;
+		uint8_t mask;
+		uint8_t value;
+		uint8_t *result; /* Optional, receives the register value after this step */
+
+	} RegisterAccess;
+
+	/**
+	 * @brief Accepts a packet if (payload[offset + i] & mask[i]) == value[i] for every i < length.
+	 * Typically matches a network id or destination address at the start of the payload.
+	 */
+	typedef struct
+	{
+		uint8_t offset;
+		uint8_t length; /* At most 4 */
+		uint8_t value[4];
+		uint8_t mask[4];
+
+	} RxFilter;
+
+	/* Timing of a packet on air, microseconds on the Device clock */
+	typedef struct
+	{
+		int64_t start_us; /* End minus time on air */
+		int64_t end_us;	  /* TxDone or RxDone */
+		int64_t preamble_us; /* PreambleDetected, RX only. 0 if not captured */
+
+	} PacketTime;
+
+	/* Result of a channel scan, levels in dBm */
+	typedef struct
+	{
+		uint32_t frequency;
+		int16_t noise_floor; /* Median of the samples */
+		int16_t peak;
+
+	} ChannelNoise;
+
+	/* Levels of the last received packet */
+	typedef struct
+	{
+		int16_t rssi;		 /* dBm, averaged over the packet. GFSK: at sync word */
+		int8_t snr;			 /* dB, LoRa only */
+		int16_t signal_rssi; /* dBm, LoRa signal after despreading. GFSK: average over the packet */
+
+	} PacketStatus;
+
+	/* A frame sent or received by the driver, see Capture_Sink */
+	typedef struct
+	{
+		int64_t start_us;	/* Device clock, see PacketTime */
+		uint32_t frequency; /* Hz */
+		LLCC68_Constants::PacketType packet_type;
+		LLCC68_Constants::SF sf; /* sf, bw and cr are only valid for LoRa */
+		LLCC68_Constants::BW bw;
+		LLCC68_Constants::CR cr;
+		PacketStatus status; /* RX only */
+		bool tx;
+		bool crc_ok;
+		const uint8_t *payload; /* Only valid during the call */
+		uint8_t size;
+
+	} CapturedFrame;
+
+	/**
+	 * @brief Receives every frame the driver sends or receives, CRC failures included.
+	 */
+	class Capture_Sink
+	{
+	public:
+		/* Called on the radio loop, copy the frame and return quickly */
+		virtual void capture(const CapturedFrame &frame) = 0;
+
+		virtual ~Capture_Sink() = default;
+	};
+
+	/* Device states the driver accounts energy for */
+	enum class RadioState : uint8_t
+	{
+		SLEEP_COLD,
+		SLEEP_WARM,
+		STDBY_RC,
+		STDBY_XOSC,
+		RX,
+		TX,
+		CAD
+
+	};
+
+	constexpr uint8_t n_radio_states = 7;
+
+	typedef struct
+	{
+		int8_t power_dbm;
+		uint32_t current_na;
+
+	} TxCurrent;
+
+	/* Supply current of each state in nanoamps, see set_current_table */
+	typedef struct
+	{
+		uint32_t sleep_cold_na;
+		uint32_t sleep_warm_na;
+		uint32_t standby_rc_na;
+		uint32_t standby_xosc_na;
+		uint32_t rx_na;
+		uint32_t cad_na;
+		uint8_t n_tx_points;
+		TxCurrent tx[8]; /* Ascending power, interpolated linearly in between */
+
+	} CurrentTable;
+
+	/**
+	 * Typical datasheet figures with DC-DC and the recommended PA config for each power.
+	 * TX current depends on pa_config and the matching network, measure the board for real numbers.
+	 */
+	constexpr CurrentTable llcc68_default_currents{
+		160, 600, 600000, 800000, 4600000, 3800000, 7,
+		{{-9, 20000000}, {0, 25000000}, {10, 32000000}, {14, 45000000}, {17, 58000000}, {20, 84000000}, {22, 118000000}}};
+
+	/* Time and charge per RadioState, indexed by its value */
+	typedef struct
+	{
+		int64_t residency_us[n_radio_states];
+		double charge_uah[n_radio_states];
+		uint32_t tx_packets;
+		uint32_t tx_bytes;
+		uint32_t rx_packets;
+		uint32_t rx_bytes;
+
+	} EnergyLedger;
+
 	class LLCC68
 	{
 	public:
+		/* Check get_last_error(), TIMED_OUT if TxDone never came */
 		virtual void send_packet(const uint8_t *packet, uint8_t size) = 0;
+		/**
+		 * @brief Sends the segments back to back as one packet. Segments are streamed
+		 * straight into the device buffer, no need to assemble them first.
+		 * @param count Amount of segments. Total size must not exceed 255 bytes.
+		 */
+		virtual void send_packet(const Segment *segments, uint8_t count) = 0;
+		/**
+		 * @brief Receives a single packet. Device is left in STDBY_RC.
+		 * @param buffer Make sure buffer is at least max_size bytes. Longer packets are truncated.
+		 * @param timeout_ms Time to wait for a packet to start.
+		 * @return Amount of bytes stored in buffer, 0 on timeout or error. Check get_last_error().
+		 */
+		virtual uint8_t receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms) = 0;
+		/**
+		 * @brief Receives the first packet accepted by the filter. Filtered bytes are read as soon
+		 * as the header is valid and foreign packets are aborted right away, listening continues
+		 * until the timeout.
+		 */
+		virtual uint8_t receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, const RxFilter &filter) = 0;
+		/**
+		 * @brief Short receive window for scheduled slots. The window closes after n_symbols
+		 * symbols of the active SF/BW unless a preamble is detected, in which case it is
+		 * extended until the packet is received.
+		 * @return Amount of bytes stored in buffer, 0 on timeout or error.
+		 */
+		virtual uint8_t receive_window(uint8_t *buffer, uint8_t max_size, uint8_t n_symbols) = 0;
+
+		/**
+		 * Non-blocking operations. Start one, then call the matching finish function once
+		 * is_irq_pending() is true, or cancel() to give up. See Async_Radio.
+		 */
+
+		/**
+		 * @brief Starts sending the segments as one packet. Device returns to STDBY_RC when done.
+		 * @return false if the packet is empty or larger than 255 bytes.
+		 */
+		virtual bool start_transmit(const Segment *segments, uint8_t count) = 0;
+		/**
+		 * @brief Starts single RX, see receive_packet.
+		 * @return false if the timeout is out of range.
+		 */
+		virtual bool start_receive(uint32_t timeout_ms) = 0;
+		/**
+		 * @brief Starts channel activity detection with the active LoRa params.
+		 * Detection thresholds are the ones recommended for BW 125kHz, other bandwidths are rejected.
+		 * @return false if LoRa is not active or the bandwidth isn't 125kHz.
+		 */
+		virtual bool start_cad(LLCC68_Constants::CadSymbolNum symbolNum = LLCC68_Constants::CadSymbolNum::CAD_ON_2_SYMB) = 0;
+		/* @return false if TX timed out */
+		virtual bool finish_transmit() = 0;
+		/* @return Amount of bytes stored in buffer, 0 on timeout or error. Check get_last_error(). */
+		virtual uint8_t finish_receive(uint8_t *buffer, uint8_t max_size) = 0;
+		/* @return true if LoRa activity was detected */
+		virtual bool finish_cad() = 0;
+		/* DIO1 is high, i.e. the started operation has finished */
+		bool is_irq_pending();
+		/* Stops the started operation, device is left in STDBY_RC */
+		void cancel();
+
 		void reset();
 		void sleep(SleepConfig sleepConfig);
-		/* Device defaults to 0x1D0F */
+		/* GFSK CRC polynomial, device defaults to 0x1021 */
 		void set_crc_poly(uint16_t crc16);
+		/* GFSK CRC initial value, device defaults to 0x1D0F */
+		void set_crc_init(uint16_t crc16);
+		/**
+		 * @brief GFSK sync word, up to 8 bytes. Its length on air is set by packet params.
+		 */
+		void set_sync_word(const uint8_t *sync_word, uint8_t n);
+		/* GFSK whitening seed, 9 bits */
+		void set_whitening_seed(uint16_t seed);
+		/**
+		 * @brief Runs the accesses in order with as few transactions as possible. Register values are
+		 * cached: reads and read-modify-writes of known registers send nothing, writes of the value a
+		 * register already holds are skipped, and registers at most a few addresses apart share one
+		 * read or write transaction. The cache assumes registers only change through the driver,
+		 * it is dropped on reset and sleep.
+		 * @param count At most max_register_accesses.
+		 * @return false if there are too many accesses, nothing is sent then.
+		 */
+		bool access_registers(const RegisterAccess *accesses, uint8_t count);
+		/* Forgets the cached register values, the next access reads them from the device */
+		void invalidate_register_cache();
+		/**
+		 * @brief Switches between LoRa and GFSK. Params of the other modem are kept from the last
+		 * time it was active (or from the config), so a switch costs standby, packet type,
+		 * modulation and packet params commands only.
+		 * @return false if params of the requested modem were never configured.
+		 */
+		bool switch_packet_type(LLCC68_Constants::PacketType packetType);
+		/**
+		 * @brief Moves the device to a new config without a full init. Only commands whose parameters
+		 * changed are sent, in init order, with the device put in STDBY_RC first if needed. Params of
+		 * the inactive modem are only cached. The whole config is validated before anything is sent.
+		 * Changing LoRa packet params leaves fixed frame mode and updates the registered classes.
+		 * @return false if the config is invalid (INVALID_PARAMETER), changes TCXO settings or the
+		 * device is in cold sleep (UNSUPPORTED). Nothing is changed then.
+		 */
+		bool apply_config(const LLCC68_config &new_config);
+		inline const LLCC68_config &get_config() const { return config; }
+		/**
+		 * @brief Ranges and SF/BW combinations the LLCC68 supports. The inactive modem is only checked
+		 * when configured: LoRa with a non zero SF, GFSK with a non zero bitrate.
+		 */
+		static bool is_valid_config(const LLCC68_config &config);
+		inline LLCC68_Constants::PacketType get_packet_type() const { return active_packet_type; }
 		inline ErrorCode get_last_error() const { return last_error; }
+		/* So the error read after an operation is the one it reported, not one left from before */
+		inline void clear_last_error() { last_error = ErrorCode::NO_ERROR; }
+		inline Device &get_device() const { return *_device; }
+		inline uint32_t get_frequency() const { return config.rf_freq; }
+		/**
+		 * @brief Latches the time of a DIO1 rising edge. Call it from the DIO1 interrupt handler
+		 * for precise timestamps, otherwise edges are timestamped when polling notices them.
+		 */
+		void on_dio1_edge();
+		/* Timing of the last packet sent */
+		inline const PacketTime &get_tx_time() const { return tx_time; }
+		/* Timing of the last packet received */
+		inline const PacketTime &get_rx_time() const { return rx_time; }
+		/**
+		 * @brief Energy used since construction or the last reset_energy_ledger(). States follow the
+		 * commands the driver issues, TX/RX/CAD end when their IRQ is cleared.
+		 */
+		const EnergyLedger &get_energy_ledger();
+		/* Total charge of the ledger */
+		double get_consumed_mah();
+		void reset_energy_ledger();
+		/* Applies to time spent from now on */
+		void set_current_table(const CurrentTable &table);
+		inline RadioState get_radio_state() const { return radio_state; }
+		/**
+		 * @brief Hands every frame sent or received from now on to the sink, nullptr stops capturing.
+		 * Capturing costs a packet status read per received frame, and reading back the TX buffer
+		 * for frames sent with start_transmit.
+		 */
+		inline void set_capture_sink(Capture_Sink *sink) { capture_sink = sink; }
+		/* Packets aborted by an RxFilter so far */
+		inline uint32_t get_filtered_count() const { return filtered_packets; }
+		/**
+		 * @brief Retunes the device. Leaves the device in STDBY_RC.
+		 * @param desired_freq Frequency in Hz.
+		 */
+		void set_frequency(uint32_t desired_freq);
+		/**
+		 * @brief Time on air of a packet with the active modulation and packet params.
+		 * @return Microseconds.
+		 */
+		uint32_t get_time_on_air(uint8_t payloadLength) const;
+		/**
+		 * @brief Instantaneous RSSI, device must be in RX.
+		 * @return dBm, rounded towards 0.
+		 */
+		int16_t get_rssi_inst();
+		/* Levels of the last packet received, valid until the next RX */
+		PacketStatus get_packet_status();
+		/**
+		 * @brief Measures the noise floor of each channel with the active modulation. The device listens
+		 * in continuous RX on each channel and, after rssi_settle_us, takes n_samples RSSI samples spread over dwell_ms.
+		 * Device is left in STDBY_RC on the original frequency.
+		 * @param frequencies Channel frequencies in Hz.
+		 * @param result Make sure it has at least n_channels entries.
+		 * @param n_samples Between 1 and max_rssi_samples.
+		 * @return Index of the quietest channel. Lowest peak breaks ties.
+		 */
+		uint8_t scan_channels(const uint32_t *frequencies, uint8_t n_channels, ChannelNoise *result, uint8_t n_samples = 8, uint32_t dwell_ms = 4);
+
+		/**
+		 * @brief Registers a fixed length message class for implicit header mode.
+		 * Packet params of the class are computed once, selecting the class later costs a single cached command.
+		 * @param frame_class Class index, must be less than max_fixed_frames.
+		 * @param length Payload length of every frame in this class.
+		 * @return false if class index or length is invalid.
+		 */
+		bool register_fixed_frame(uint8_t frame_class, uint8_t length);
+		/**
+		 * @brief Programs packet params of a registered class. Both TX and RX use the class length afterwards.
+		 * Does nothing if the class is already active.
+		 */
+		bool select_fixed_frame(uint8_t frame_class);
+		/**
+		 * @brief Restores packet params from the device config, i.e. leaves fixed frame mode.
+		 */
+		void select_variable_frame();
+		/**
+		 * @brief Sends a frame of a registered class without a LoRa header.
+		 * @param frame Make sure frame has at least the registered length of the class.
+		 */
+		void send_fixed_frame(uint8_t frame_class, const uint8_t *frame);
 
 		/* rf_freq = ((desired_freq * (2^25)) / 32) */
 		static uint32_t calculate_rf_frequency(uint32_t desired_freq);
+		/* RX/TX timeouts are counted in steps of 15.625us */
+		static uint32_t calculate_timer_steps(uint32_t us);
+		/* Tsym = 2^SF / BW, in microseconds */
+		static uint32_t calculate_symbol_time(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw);
+		/**
+		 * @brief LoRa time on air formula from the datasheet.
+		 * @return Microseconds.
+		 */
+		static uint32_t calculate_time_on_air(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldro,
+											  uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, LLCC68_Constants::CRC_Type crcType, uint8_t payloadLength);
+		/**
+		 * @brief GFSK time on air, counting preamble, sync word, optional length/address bytes and CRC.
+		 * @param preambleLength In bits.
+		 * @param syncWordLength In bits.
+		 * @return Microseconds.
+		 */
+		static uint32_t calculate_gfsk_time_on_air(uint32_t bitrate, uint16_t preambleLength, uint8_t syncWordLength, LLCC68_Constants::AddrComp addrComp,
+												   LLCC68_Constants::GFSK_PacketType packetType, LLCC68_Constants::GFSK_CRC_Type crcType, uint8_t payloadLength);
 
 		LLCC68(LLCC68 &&) = default;
 		LLCC68 &operator=(LLCC68 &&) = default;
@@ -41,7 +390,36 @@ namespace LoRa
 
 		virtual ~LLCC68() = default;
 
+		static constexpr uint8_t max_fixed_frames = 8;
+		static constexpr uint8_t max_rssi_samples = 32;
+		/* Longest receive_packet timeout, the RX timer holds 0xFFFFFE steps of 15.625us */
+		static constexpr uint32_t max_rx_timeout_ms = 262143;
+		/* RX start up and the first RSSI averaging window, scan_channels waits this long before sampling */
+		static constexpr uint32_t rssi_settle_us = 1000;
+		static constexpr uint8_t max_register_accesses = 24;
+		static constexpr uint8_t register_cache_size = 32;
+
 	protected:
+		/* Command sizes including the opcode */
+		static constexpr uint8_t lora_modulation_params_size = 5;
+		static constexpr uint8_t gfsk_modulation_params_size = 9;
+		static constexpr uint8_t lora_packet_params_size = 7;
+		static constexpr uint8_t gfsk_packet_params_size = 10;
+
+		typedef struct
+		{
+			uint8_t length; /* 0 means not registered */
+			uint8_t packet_params[lora_packet_params_size];
+
+		} FixedFrame;
+
+		typedef struct
+		{
+			uint16_t address;
+			uint8_t value;
+
+		} CachedRegister;
+
 		LLCC68(const LLCC68_pins &pins, const LLCC68_config &config, std::unique_ptr<LoRa_SPI> spi, std::unique_ptr<LoRa_IO> io, std::unique_ptr<Device> device);
 
 		virtual bool init_llcc68() = 0;
@@ -57,6 +435,21 @@ namespace LoRa
 		 * @param timeout 24-bit timeout value multiplied by 15.625us. Pass 0 to disable timeout.
 		 */
 		void set_rx(int32_t timeout = 6400);
+		/**
+		 * @brief Stop RX timeout timer on preamble detection instead of header/sync word.
+		 */
+		void set_stop_timer_on_preamble(LLCC68_Constants::Enable enable);
+		/**
+		 * @brief Number of symbols the modem searches for a preamble before a timeout. 0 disables it.
+		 */
+		void set_lora_symb_num_timeout(uint8_t symbNum);
+		/**
+		 * @param detPeak Correlation threshold, depends on SF and symbolNum.
+		 * @param detMin Minimum peak to noise ratio.
+		 * @param timeout RX timeout in 15.625us steps, only used by CAD_RX.
+		 */
+		void set_cad_params(LLCC68_Constants::CadSymbolNum symbolNum, uint8_t detPeak, uint8_t detMin, LLCC68_Constants::CadExitMode exitMode, uint32_t timeout);
+		void set_cad();
 		void set_regulator_mode(LLCC68_Constants::RegModeParam regMode);
 		/**
 		 * @brief PA stands for power amplifier
@@ -65,14 +458,15 @@ namespace LoRa
 		void set_rx_tx_fallback_mode(LLCC68_Constants::FallbackMode fallbackMode);
 
 		/**
-		 * @brief Writes a continuous memory area, starting from given address.
+		 * @brief Writes a continuous memory area, starting from given address. Cached values in the area are updated.
 		 * @param address Starting address.
 		 * @param data Data to write.
 		 * @param n Amount of bytes to write.
 		 */
-		void write_register(uint16_t address, uint8_t *data, uint8_t n);
+		void write_register(uint16_t address, const uint8_t *data, uint8_t n);
 		/**
-		 * @brief Reads a continuous memory area, starting from given address.
+		 * @brief Reads a continuous memory area, starting from given address, in one burst.
+		 * Cached values in the area are updated.
 		 * @param address Starting address.
 		 * @param buffer Buffer to store read values. Make sure buffer size is at least n bytes.
 		 * @param n Amount of bytes to read.
@@ -85,6 +479,11 @@ namespace LoRa
 		 * @param offset Address offest within the device buffer.
 		 */
 		void write_buffer(const uint8_t *data, uint8_t n, uint8_t offset = 0);
+		/**
+		 * @brief Writes the segments back to back in a single transaction.
+		 * @param offset Address offset of the first segment within the device buffer.
+		 */
+		void write_buffer(const Segment *segments, uint8_t count, uint8_t offset = 0);
 		/**
 		 * @brief Read n bytes from the payload buffer.
 		 * @param buffer Byte array to hold read values. Make sure buffer is at least n bytes.
@@ -106,13 +505,97 @@ namespace LoRa
 		 * */
 		void set_tx_params(int8_t power_dbm, LLCC68_Constants::RampTime rampTime);
 		void set_lora_modulation_params(LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldOpt);
+		/**
+		 * @param bitrate In bps, between 600 and 300000.
+		 * @param fdev Frequency deviation in Hz.
+		 */
+		void set_gfsk_modulation_params(uint32_t bitrate, LLCC68_Constants::PulseShape pulseShape, LLCC68_Constants::GFSK_BW bandwidth, uint32_t fdev);
 		/**
 		 * @param preambleLength number of LoRa symbols as preamble. Datasheet recommends at least 12 if using faster bitrates.
 		 */
 		void set_lora_packet_params(uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, uint8_t payloadLength, LLCC68_Constants::CRC_Type crcType, LLCC68_Constants::InvertIQ invertIq);
+		/**
+		 * @param preambleLength In bits.
+		 * @param syncWordLength In bits, at most 64.
+		 */
+		void set_gfsk_packet_params(uint16_t preambleLength, LLCC68_Constants::PreambleDetector preambleDetectorLength, uint8_t syncWordLength,
+									LLCC68_Constants::AddrComp addrComp, LLCC68_Constants::GFSK_PacketType packetType, uint8_t payloadLength,
+									LLCC68_Constants::GFSK_CRC_Type crcType, LLCC68_Constants::Whitening whitening);
+		/**
+		 * @brief Builds the command of the modem that is not active, to be sent by switch_packet_type.
+		 */
+		void prepare_inactive_modem();
+
+		static void build_lora_modulation_params(uint8_t *command, LLCC68_Constants::SF sf, LLCC68_Constants::BW bw, LLCC68_Constants::CR cr, LLCC68_Constants::LDRO ldOpt);
+		static void build_gfsk_modulation_params(uint8_t *command, uint32_t bitrate, LLCC68_Constants::PulseShape pulseShape, LLCC68_Constants::GFSK_BW bandwidth, uint32_t fdev);
+		static void build_lora_packet_params(uint8_t *command, uint16_t preambleLength, LLCC68_Constants::HeaderType headerType, uint8_t payloadLength,
+											 LLCC68_Constants::CRC_Type crcType, LLCC68_Constants::InvertIQ invertIq);
+		static void build_gfsk_packet_params(uint8_t *command, uint16_t preambleLength, LLCC68_Constants::PreambleDetector preambleDetectorLength, uint8_t syncWordLength,
+											 LLCC68_Constants::AddrComp addrComp, LLCC68_Constants::GFSK_PacketType packetType, uint8_t payloadLength,
+											 LLCC68_Constants::GFSK_CRC_Type crcType, LLCC68_Constants::Whitening whitening);
+		/**
+		 * @brief Reprograms payload length of the active packet params. Sends nothing if the length is already set.
+		 */
+		void set_payload_length(uint8_t payloadLength);
+		/* Payload length in the active packet params */
+		inline uint8_t get_payload_length() const { return active_packet_params[(active_packet_type == LLCC68_Constants::PacketType::LORA) ? 4 : 7]; }
 		void set_buffer_base_address(uint8_t tx_base_addr, uint8_t rx_base_addr);
+		void get_rx_buffer_status(uint8_t *payloadLength, uint8_t *rxStartBufferPointer);
+
+		/**
+		 * @brief Sends a prebuilt command in a single transaction.
+		 * @param command Opcode followed by its parameters.
+		 * @param n Total amount of bytes, including the opcode.
+		 */
+		void write_command(const uint8_t *command, uint8_t n);
+		/**
+		 * @brief Time from HeaderValid until the first n payload bytes are in the RX buffer.
+		 * @return Microseconds, rounded up to whole coding blocks.
+		 */
+		uint32_t get_time_to_payload_bytes(uint8_t n) const;
+		static bool filter_matches(const RxFilter &filter, const uint8_t *payload);
+		/* Sync word, whitening, CRC and address registers from the config */
+		void write_gfsk_settings();
+		/* Refreshes packet params of the registered fixed frames from the config */
+		void rebuild_fixed_frames();
 
-		void wait_for_irq_tx_done(int dio_pin);
+		/**
+		 * @brief Time of the DIO1 edge latched by on_dio1_edge(), or the current time if none was latched.
+		 */
+		int64_t take_dio1_edge();
+		/**
+		 * @brief Sets the packet end to the last IRQ time and derives the start from time on air.
+		 * Packets stamped successfully are counted in the energy ledger.
+		 */
+		void stamp_packet(PacketTime &time, uint8_t payloadLength);
+		/**
+		 * @brief Passes a sent frame to the capture sink, if any. Call after stamp_packet, unstamped
+		 * frames (no TxDone) are not captured.
+		 * @param segments nullptr reads the payload back from the TX buffer.
+		 */
+		void capture_tx(const Segment *segments, uint8_t count);
+		/**
+		 * @brief Passes a received frame to the capture sink, if any. Call after stamp_packet.
+		 * @param payload nullptr reads the whole frame from the RX buffer, for frames that failed the CRC
+		 * or whose copy was truncated. size is ignored then.
+		 */
+		void capture_rx(const uint8_t *payload, uint8_t size, bool crc_ok);
+		/**
+		 * @brief Books the time since the last transition to the current state and switches state.
+		 * @param at_us Time of the transition, -1 for now.
+		 */
+		void enter_state(RadioState state, int64_t at_us = -1);
+		uint32_t get_state_current(RadioState state) const;
+		/* nullptr if the register isn't cached */
+		CachedRegister *find_cached_register(uint16_t address);
+		/* Adds or updates the cached value, evicting the oldest entry once the cache is full */
+		void cache_register(uint16_t address, uint8_t value);
+
+		/**
+		 * @brief Waits until the DIO pin goes high.
+		 * @return false if timed out.
+		 */
+		bool wait_for_irq(int dio_pin, int32_t timeout_ms);
 		void wait_busy(int32_t timeout = -1);
 		bool is_busy();
 
@@ -122,6 +605,31 @@ namespace LoRa
 		std::unique_ptr<LoRa_SPI> _spi;
 		std::unique_ptr<LoRa_IO> _io;
 		std::unique_ptr<Device> _device;
+
+		LLCC68_Constants::PacketType active_packet_type;
+		uint8_t active_packet_params[gfsk_packet_params_size]; // Last packet params sent to the device
+		uint8_t active_packet_params_size;
+		uint8_t parked_packet_params[gfsk_packet_params_size]; // Packet params of the inactive modem
+		uint8_t parked_packet_params_size;					   // 0 if the inactive modem is not configured
+		uint8_t lora_modulation_params[lora_modulation_params_size];
+		uint8_t gfsk_modulation_params[gfsk_modulation_params_size];
+		FixedFrame fixed_frames[max_fixed_frames];
+		uint32_t filtered_packets;
+		volatile int64_t dio1_edge_us; // Written by on_dio1_edge()
+		volatile bool dio1_edge_latched;
+		int64_t irq_time_us; // When the last awaited IRQ was raised
+		PacketTime tx_time;
+		PacketTime rx_time;
+		CurrentTable current_table;
+		EnergyLedger energy;
+		RadioState radio_state;
+		int64_t state_since_us;
+		int8_t tx_power_dbm; // Last SET_TX_PARAMS
+		bool rx_continuous;	 // RX doesn't end on RxDone
+		CachedRegister register_cache[register_cache_size];
+		uint8_t n_cached_registers;
+		uint8_t next_evicted_register; // Round robin once the cache is full
+		Capture_Sink *capture_sink;
 	};
 }
 
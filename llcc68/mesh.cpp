@@ -0,0 +1,375 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "mesh.h"
+#include <cstring>
+
+using LoRa::Mesh_Router;
+
+namespace
+{
+	uint16_t read_u16(const uint8_t *p)
+	{
+		return static_cast<uint16_t>(p[0] | (p[1] << 8));
+	}
+
+	void write_u16(uint8_t *p, uint16_t value)
+	{
+		p[0] = static_cast<uint8_t>(value);
+		p[1] = static_cast<uint8_t>(value >> 8);
+	}
+
+	/* Header field offsets */
+	constexpr uint8_t destination_at = 0;
+	constexpr uint8_t source_at = 2;
+	constexpr uint8_t next_hop_at = 4;
+	constexpr uint8_t last_hop_at = 6;
+	constexpr uint8_t sequence_at = 8;
+	constexpr uint8_t ttl_at = 10;
+
+	/* A route through another neighbour must be this much stronger to replace one with as many hops */
+	constexpr int16_t rssi_hysteresis_db = 3;
+}
+
+Mesh_Router::Mesh_Router(LLCC68 &radio, uint16_t address, uint8_t ttl, uint32_t max_delay_ms, uint32_t lifetime_ms)
+	: radio{radio}, address{address}, ttl{(ttl > max_ttl) ? max_ttl : ttl}, max_delay_ms{max_delay_ms}, lifetime_ms{lifetime_ms},
+	  sequence{0}, random_state{0x9E3779B9u * (static_cast<uint32_t>(address) + 1)}, seen{}, routes{}, pending{}, n_pending{0},
+	  stats{}, last_error{ErrorCode::NO_ERROR}
+{
+}
+
+bool LoRa::Mesh_Router::send(uint16_t destination, const uint8_t *payload, uint8_t size)
+{
+	if (size > max_payload_size)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	const Route *route = find_route(destination);
+	uint8_t header[header_size];
+
+	write_u16(header + destination_at, destination);
+	write_u16(header + source_at, address);
+	write_u16(header + next_hop_at, (route != nullptr) ? route->next_hop : broadcast_address);
+	write_u16(header + last_hop_at, address);
+	write_u16(header + sequence_at, sequence);
+	header[ttl_at] = static_cast<uint8_t>(ttl << 4);
+
+	/* Our own frame relayed back to us is a duplicate */
+	check_and_insert((static_cast<uint32_t>(address) << 16) | sequence, radio.get_device().timestamp_64());
+	sequence++;
+
+	const Segment segments[] = {{header, header_size}, {payload, size}};
+	radio.clear_last_error();
+	radio.send_packet(segments, 2);
+	last_error = radio.get_last_error();
+	if (last_error != ErrorCode::NO_ERROR)
+	{
+		return false;
+	}
+	stats.originated++;
+
+	return true;
+}
+
+uint8_t LoRa::Mesh_Router::receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint16_t *source)
+{
+	Device &device = radio.get_device();
+	const int64_t deadline = device.timestamp_64() + timeout_ms;
+
+	while (true)
+	{
+		poll();
+
+		const int64_t now = device.timestamp_64();
+		if (now >= deadline)
+		{
+			last_error = ErrorCode::TIMED_OUT;
+			return 0;
+		}
+
+		/* Wake up in time for the next relay */
+		const int64_t next_due = get_next_due();
+		const int64_t until = (next_due < deadline) ? next_due : deadline;
+		int64_t wait_ms = (until > now) ? (until - now) : 1;
+		/* Longer waits are split, the device timer can't hold them */
+		if (wait_ms > LLCC68::max_rx_timeout_ms)
+		{
+			wait_ms = LLCC68::max_rx_timeout_ms;
+		}
+
+		const uint8_t size = radio.receive_packet(buffer, max_size, static_cast<uint32_t>(wait_ms));
+		if (size == 0)
+		{
+			const ErrorCode error = radio.get_last_error();
+
+			/* Noise and corrupted frames are part of listening, anything else won't go away by retrying */
+			if ((error != ErrorCode::NO_ERROR) && (error != ErrorCode::TIMED_OUT) && (error != ErrorCode::CRC_ERROR) &&
+				(error != ErrorCode::HEADER_ERROR))
+			{
+				last_error = error;
+				return 0;
+			}
+			continue;
+		}
+
+		if (handle(buffer, size, radio.get_packet_status().rssi))
+		{
+			if (source != nullptr)
+			{
+				*source = read_u16(buffer + source_at);
+			}
+
+			const uint8_t payload_size = size - header_size;
+			std::memmove(buffer, buffer + header_size, payload_size);
+			stats.delivered++;
+			last_error = ErrorCode::NO_ERROR;
+
+			return payload_size;
+		}
+	}
+}
+
+void LoRa::Mesh_Router::poll()
+{
+	const int64_t now = radio.get_device().timestamp_64();
+	uint8_t i = 0;
+
+	while (i < n_pending)
+	{
+		if (pending[i].due_ms > now)
+		{
+			i++;
+			continue;
+		}
+
+		radio.clear_last_error();
+		radio.send_packet(pending[i].frame, pending[i].size);
+		if (radio.get_last_error() == ErrorCode::NO_ERROR)
+		{
+			stats.forwarded++;
+		}
+		else
+		{
+			/* Not retried, a late relay is worth less than the airtime it takes */
+			stats.relay_failed++;
+		}
+
+		/* Order doesn't matter, fill the hole with the last entry */
+		n_pending--;
+		if (i != n_pending)
+		{
+			pending[i] = pending[n_pending];
+		}
+	}
+}
+
+const Mesh_Router::Route *LoRa::Mesh_Router::find_route(uint16_t destination) const
+{
+	const int64_t now = radio.get_device().timestamp_64();
+
+	for (uint8_t i = 0; i < max_routes; i++)
+	{
+		const Route &route = routes[i];
+
+		if (route.valid && (route.destination == destination) && ((now - route.heard_ms) <= lifetime_ms))
+		{
+			return &route;
+		}
+	}
+
+	return nullptr;
+}
+
+bool LoRa::Mesh_Router::handle(uint8_t *frame, uint8_t size, int16_t rssi)
+{
+	if (size < header_size)
+	{
+		return false;
+	}
+
+	const int64_t now = radio.get_device().timestamp_64();
+	const uint16_t destination = read_u16(frame + destination_at);
+	const uint16_t source = read_u16(frame + source_at);
+	const uint16_t next_hop = read_u16(frame + next_hop_at);
+	const uint16_t last_hop = read_u16(frame + last_hop_at);
+	const uint8_t frame_ttl = frame[ttl_at] >> 4;
+	const uint8_t hops = frame[ttl_at] & 0x0F;
+	const uint32_t key = (static_cast<uint32_t>(source) << 16) | read_u16(frame + sequence_at);
+
+	if ((source != address) && (last_hop != address))
+	{
+		learn(last_hop, last_hop, 1, rssi, now);
+		learn(source, last_hop, static_cast<uint8_t>(hops + 1), rssi, now);
+	}
+
+	if (check_and_insert(key, now))
+	{
+		stats.suppressed++;
+		cancel_pending(key);
+		return false;
+	}
+
+	if (destination == address)
+	{
+		return true;
+	}
+
+	const bool for_us = (destination == broadcast_address);
+
+	if ((next_hop != broadcast_address) && (next_hop != address))
+	{
+		stats.not_on_path++;
+		return for_us;
+	}
+	if (frame_ttl <= 1)
+	{
+		stats.ttl_expired++;
+		return for_us;
+	}
+	if (n_pending == max_pending)
+	{
+		stats.queue_full++;
+		return for_us;
+	}
+
+	/* Never hand the frame back to where it came from */
+	const Route *route = find_route(destination);
+	const uint16_t relay_to = ((route != nullptr) && (route->next_hop != last_hop)) ? route->next_hop : broadcast_address;
+	Pending &relay = pending[n_pending++];
+
+	std::memcpy(relay.frame, frame, size);
+	write_u16(relay.frame + next_hop_at, relay_to);
+	write_u16(relay.frame + last_hop_at, address);
+	relay.frame[ttl_at] = static_cast<uint8_t>(((frame_ttl - 1) << 4) | ((hops < 0x0F) ? hops + 1 : 0x0F));
+	relay.size = size;
+	relay.key = key;
+	relay.due_ms = now + ((max_delay_ms > 0) ? (random() % max_delay_ms) : 0);
+	relay.flooded = (relay_to == broadcast_address);
+
+	return for_us;
+}
+
+void LoRa::Mesh_Router::learn(uint16_t source, uint16_t last_hop, uint8_t hops, int16_t rssi, int64_t now)
+{
+	Route *slot = nullptr;
+
+	for (uint8_t i = 0; i < max_routes; i++)
+	{
+		Route &route = routes[i];
+
+		if (route.valid && (route.destination == source))
+		{
+			slot = &route;
+			break;
+		}
+		/* Free slot first, then the route heard longest ago */
+		if ((slot == nullptr) || (slot->valid && (!route.valid || (route.heard_ms < slot->heard_ms))))
+		{
+			slot = &route;
+		}
+	}
+
+	if (slot->valid && (slot->destination == source))
+	{
+		if (slot->next_hop == last_hop)
+		{
+			slot->rssi = static_cast<int16_t>(slot->rssi + (rssi - slot->rssi) / 4);
+			slot->hops = hops;
+			slot->heard_ms = now;
+			return;
+		}
+
+		const bool stale = (now - slot->heard_ms) > lifetime_ms;
+		const bool better = (hops < slot->hops) || ((hops == slot->hops) && (rssi > slot->rssi + rssi_hysteresis_db));
+		if (!stale && !better)
+		{
+			return;
+		}
+	}
+
+	slot->destination = source;
+	slot->next_hop = last_hop;
+	slot->hops = hops;
+	slot->rssi = rssi;
+	slot->heard_ms = now;
+	slot->valid = true;
+}
+
+bool LoRa::Mesh_Router::check_and_insert(uint32_t key, int64_t now)
+{
+	/* Fibonacci hashing, linear probing over a short window. Expired entries are reused, if the
+	   whole window is live the oldest entry is overwritten. */
+	const uint8_t home = static_cast<uint8_t>((key * 2654435761u) >> 24);
+	Seen *victim = nullptr;
+	bool victim_live = true;
+
+	for (uint8_t i = 0; i < max_probes; i++)
+	{
+		Seen &entry = seen[(home + i) & (duplicate_cache_size - 1)];
+		const bool live = entry.valid && ((now - entry.seen_ms) <= lifetime_ms);
+
+		if (live && (entry.key == key))
+		{
+			return true;
+		}
+		if (victim_live && (!live || (victim == nullptr) || (entry.seen_ms < victim->seen_ms)))
+		{
+			victim = &entry;
+			victim_live = live;
+		}
+	}
+
+	victim->key = key;
+	victim->seen_ms = now;
+	victim->valid = true;
+
+	return false;
+}
+
+void LoRa::Mesh_Router::cancel_pending(uint32_t key)
+{
+	for (uint8_t i = 0; i < n_pending; i++)
+	{
+		if ((pending[i].key == key) && pending[i].flooded)
+		{
+			stats.cancelled++;
+			n_pending--;
+			if (i != n_pending)
+			{
+				pending[i] = pending[n_pending];
+			}
+			return;
+		}
+	}
+}
+
+uint32_t LoRa::Mesh_Router::random()
+{
+	/* xorshift32 */
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+
+	return random_state;
+}
+
+int64_t LoRa::Mesh_Router::get_next_due() const
+{
+	int64_t next = INT64_MAX;
+
+	for (uint8_t i = 0; i < n_pending; i++)
+	{
+		if (pending[i].due_ms < next)
+		{
+			next = pending[i].due_ms;
+		}
+	}
+
+	return next;
+}
@@ -0,0 +1,145 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Multi-hop forwarding on top of LLCC68.
+ * Frame layout: [destination 2][source 2][next hop 2][last hop 2][sequence 2][ttl 4 | hops 4][payload], little endian fields.
+ */
+
+#ifndef __LLCC68_MESH_H__
+#define __LLCC68_MESH_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Forwards frames of other nodes while receiving. Routes are learned from the frames heard:
+	 * the neighbour a source was heard through with the fewest hops, stronger RSSI breaking ties,
+	 * becomes the next hop towards that source. Frames to destinations without a route are flooded.
+	 * Every frame is relayed at most once per node, and a pending flood relay is dropped if another
+	 * node is heard relaying the same frame first.
+	 */
+	class Mesh_Router
+	{
+	public:
+		static constexpr uint16_t broadcast_address = 0xFFFF;
+		static constexpr uint8_t header_size = 11;
+		static constexpr uint8_t max_payload_size = 255 - header_size;
+		static constexpr uint8_t max_ttl = 15;
+		/* Power of 2 */
+		static constexpr uint8_t duplicate_cache_size = 64;
+		static constexpr uint8_t max_probes = 8;
+		static constexpr uint8_t max_routes = 16;
+		static constexpr uint8_t max_pending = 4;
+
+		typedef struct
+		{
+			uint32_t originated;
+			uint32_t delivered;	  /* To this node, broadcasts included */
+			uint32_t forwarded;
+			uint32_t relay_failed; /* Relays the radio couldn't send */
+			uint32_t suppressed;  /* Duplicates dropped on reception */
+			uint32_t cancelled;	  /* Pending relays dropped after hearing another relay */
+			uint32_t ttl_expired; /* Not relayed because the TTL ran out */
+			uint32_t not_on_path; /* Unicast frames routed through another neighbour */
+			uint32_t queue_full;
+
+		} Stats;
+
+		typedef struct
+		{
+			uint16_t destination;
+			uint16_t next_hop;
+			uint8_t hops;
+			int16_t rssi; /* dBm, link to next_hop, averaged */
+			int64_t heard_ms;
+			bool valid;
+
+		} Route;
+
+		/**
+		 * @param ttl Hops a new frame may take, at most max_ttl.
+		 * @param max_delay_ms Relays wait a random time below this, so neighbours relaying the same frame don't collide.
+		 * @param lifetime_ms How long duplicates are remembered and routes are trusted.
+		 */
+		Mesh_Router(LLCC68 &radio, uint16_t address, uint8_t ttl = 4, uint32_t max_delay_ms = 200, uint32_t lifetime_ms = 60000);
+
+		/**
+		 * @brief Sends the payload towards the destination, flooding it if there is no route.
+		 * @return false if the payload is too large or the radio failed to send, check get_last_error().
+		 */
+		bool send(uint16_t destination, const uint8_t *payload, uint8_t size);
+		/**
+		 * @brief Listens until a frame for this node arrives, relaying other frames meanwhile. The payload
+		 * is moved to the start of the buffer.
+		 * @param buffer Must hold the whole frame, i.e. payload + header_size bytes.
+		 * @param source Optional, set to the originator.
+		 * @param timeout_ms Any length, waits beyond LLCC68::max_rx_timeout_ms are split.
+		 * @return Payload size, 0 on timeout or if the radio can't receive, check get_last_error().
+		 */
+		uint8_t receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint16_t *source = nullptr);
+		/**
+		 * @brief Sends relays that are due. receive() does this too, call it when not receiving.
+		 */
+		void poll();
+
+		/* nullptr if there is no fresh route */
+		const Route *find_route(uint16_t destination) const;
+		inline const Stats &get_stats() const { return stats; }
+		inline uint8_t get_pending_count() const { return n_pending; }
+		inline uint16_t get_address() const { return address; }
+		inline ErrorCode get_last_error() const { return last_error; }
+
+	private:
+		typedef struct
+		{
+			uint32_t key; /* source << 16 | sequence */
+			int64_t seen_ms;
+			bool valid;
+
+		} Seen;
+
+		typedef struct
+		{
+			uint8_t frame[255];
+			uint8_t size;
+			uint32_t key;
+			int64_t due_ms;
+			bool flooded;
+
+		} Pending;
+
+		/**
+		 * @brief Handles a received frame: learns the route, drops duplicates and queues the relay.
+		 * @return true if the frame is for this node.
+		 */
+		bool handle(uint8_t *frame, uint8_t size, int16_t rssi);
+		void learn(uint16_t source, uint16_t last_hop, uint8_t hops, int16_t rssi, int64_t now);
+		/* Returns true if the key was already in the cache, inserts it otherwise */
+		bool check_and_insert(uint32_t key, int64_t now);
+		void cancel_pending(uint32_t key);
+		uint32_t random();
+		int64_t get_next_due() const;
+
+		LLCC68 &radio;
+		uint16_t address;
+		uint8_t ttl;
+		uint32_t max_delay_ms;
+		uint32_t lifetime_ms;
+		uint16_t sequence;
+		uint32_t random_state;
+
+		Seen seen[duplicate_cache_size];
+		Route routes[max_routes];
+		Pending pending[max_pending];
+		uint8_t n_pending;
+		Stats stats;
+		ErrorCode last_error;
+	};
+}
+
+#endif // __LLCC68_MESH_H__
@@ -10,10 +10,27 @@
 LoRa::NRF_LLCC68::~NRF_LLCC68() = default;
 
 void LoRa::NRF_LLCC68::send_packet(const uint8_t *packet, uint8_t size) {
+  Segment segment{packet, size};
+  send_packet(&segment, 1);
+}
+
+void LoRa::NRF_LLCC68::send_packet(const Segment *segments, uint8_t count) {
+  last_error = ErrorCode::NO_ERROR;
+
+  uint16_t size = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    size += segments[i].size;
+  }
+
   if (size == 0) {
     return;
   }
 
+  if (size > 255) {
+    last_error = ErrorCode::INVALID_PARAMETER;
+    return;
+  }
+
   /**
    * TODO:
    * Get device status.
@@ -22,15 +39,21 @@ void LoRa::NRF_LLCC68::send_packet(const uint8_t *packet, uint8_t size) {
 
   wait_busy();
   set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
-  write_buffer(packet, size);
+  set_payload_length(static_cast<uint8_t>(size)); // TX length is taken from packet params, also in implicit header mode
+  write_buffer(segments, count);
 
   IrqMask irqMask{1};
   IrqMask dio1_mask{1};
-  IrqMask no_mask;
+  IrqMask no_mask{};
   set_dio_irq_params(irqMask, dio1_mask, no_mask, no_mask);
 
-  set_tx();
-  wait_for_irq_tx_done(pins.dio1);
+  /* Device gives up if TX takes well over its time on air, the host waits a little longer */
+  const uint32_t time_on_air_us = get_time_on_air(static_cast<uint8_t>(size));
+  set_tx(static_cast<int32_t>(calculate_timer_steps(time_on_air_us + 50000)));
+  if (wait_for_irq(pins.dio1, static_cast<int32_t>(time_on_air_us / 1000) + 100)) {
+    stamp_packet(tx_time, static_cast<uint8_t>(size));
+    capture_tx(segments, count);
+  }
   // TODO: Check for device error
   clear_irq_status(LLCC68_Constants::ClearIrqParam::TxDone);
 
@@ -38,14 +61,420 @@ void LoRa::NRF_LLCC68::send_packet(const uint8_t *packet, uint8_t size) {
                       // No IRQ set
 }
 
+uint8_t LoRa::NRF_LLCC68::receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms)
+{
+	const uint32_t rx_timeout = calculate_timer_steps(timeout_ms * 1000);
+
+	if ((timeout_ms == 0) || (rx_timeout > 0x00FFFFFE))
+	{
+		/* 0 and 0xFFFFFF have special meanings for the device */
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return 0;
+	}
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_stop_timer_on_preamble(LLCC68_Constants::Enable::FALSE);
+	if (active_packet_type == LLCC68_Constants::PacketType::LORA)
+	{
+		set_lora_symb_num_timeout(0);
+	}
+
+	/* The timer stops once the header is valid, leave room for the longest packet */
+	return receive(buffer, max_size, rx_timeout, timeout_ms + get_time_on_air(255) / 1000 + 10);
+}
+
+uint8_t LoRa::NRF_LLCC68::receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, const RxFilter &filter)
+{
+	if ((timeout_ms == 0) || (calculate_timer_steps(timeout_ms * 1000) > 0x00FFFFFE) ||
+		(filter.length == 0) || (filter.length > sizeof(filter.value)) ||
+		(static_cast<uint16_t>(filter.offset) + filter.length > 255))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return 0;
+	}
+
+	const int64_t deadline = _device->timestamp_64() + timeout_ms;
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_stop_timer_on_preamble(LLCC68_Constants::Enable::FALSE);
+	if (active_packet_type == LLCC68_Constants::PacketType::LORA)
+	{
+		set_lora_symb_num_timeout(0);
+	}
+
+	while (true)
+	{
+		const int64_t remaining = deadline - _device->timestamp_64();
+		if (remaining <= 0)
+		{
+			last_error = ErrorCode::TIMED_OUT;
+			return 0;
+		}
+
+		bool rejected = false;
+		const uint8_t size = receive(buffer, max_size, calculate_timer_steps(static_cast<uint32_t>(remaining) * 1000),
+									 static_cast<int32_t>(remaining) + get_time_on_air(255) / 1000 + 10, &filter, &rejected);
+		if (!rejected)
+		{
+			return size;
+		}
+	}
+}
+
+uint8_t LoRa::NRF_LLCC68::receive_window(uint8_t *buffer, uint8_t max_size, uint8_t n_symbols)
+{
+	const auto &lora = config.modulation_params._lora;
+	const uint32_t window_us = static_cast<uint32_t>(n_symbols) * calculate_symbol_time(lora.lora_sf, lora.bandwidth);
+
+	if (active_packet_type != LLCC68_Constants::PacketType::LORA)
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return 0;
+	}
+
+	if ((n_symbols == 0) || (n_symbols > 248))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return 0;
+	}
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	/**
+	 * The modem gives up after n_symbols without a preamble. If a preamble shows up,
+	 * the timer stops and the window lasts until the packet is received.
+	 */
+	set_stop_timer_on_preamble(LLCC68_Constants::Enable::TRUE);
+	set_lora_symb_num_timeout(n_symbols);
+
+	return receive(buffer, max_size, calculate_timer_steps(window_us) + 1,
+				   window_us / 1000 + get_time_on_air(255) / 1000 + 10);
+}
+
+bool LoRa::NRF_LLCC68::start_transmit(const Segment *segments, uint8_t count)
+{
+	uint16_t size = 0;
+	for (uint8_t i = 0; i < count; i++)
+	{
+		size += segments[i].size;
+	}
+
+	if ((size == 0) || (size > 255))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	last_error = ErrorCode::NO_ERROR;
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_payload_length(static_cast<uint8_t>(size));
+	write_buffer(segments, count);
+
+	IrqMask irqMask{};
+	irqMask.tx_done = 1;
+	irqMask.timeout = 1;
+	IrqMask no_mask{};
+
+	set_dio_irq_params(irqMask, irqMask, no_mask, no_mask);
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	/* Device gives up if TX takes well over its time on air */
+	set_tx(static_cast<int32_t>(calculate_timer_steps(get_time_on_air(static_cast<uint8_t>(size)) + 50000)));
+
+	return true;
+}
+
+bool LoRa::NRF_LLCC68::start_receive(uint32_t timeout_ms)
+{
+	const uint32_t rx_timeout = calculate_timer_steps(timeout_ms * 1000);
+
+	if ((timeout_ms == 0) || (rx_timeout > 0x00FFFFFE))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	last_error = ErrorCode::NO_ERROR;
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	set_stop_timer_on_preamble(LLCC68_Constants::Enable::FALSE);
+	if (active_packet_type == LLCC68_Constants::PacketType::LORA)
+	{
+		set_lora_symb_num_timeout(0);
+	}
+
+	IrqMask irqMask{};
+	irqMask.rx_done = 1;
+	irqMask.header_err = 1;
+	irqMask.crc_err = 1;
+	irqMask.timeout = 1;
+	IrqMask no_mask{};
+
+	set_dio_irq_params(irqMask, irqMask, no_mask, no_mask);
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	set_rx(static_cast<int32_t>(rx_timeout));
+
+	return true;
+}
+
+bool LoRa::NRF_LLCC68::start_cad(LLCC68_Constants::CadSymbolNum symbolNum)
+{
+	if ((active_packet_type != LLCC68_Constants::PacketType::LORA) ||
+		(config.modulation_params._lora.bandwidth != LLCC68_Constants::BW::LORA_BW_125))
+	{
+		last_error = ErrorCode::UNSUPPORTED;
+		return false;
+	}
+
+	last_error = ErrorCode::NO_ERROR;
+
+	set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+	/* Thresholds recommended for BW 125kHz: detPeak = SF + 13, detMin = 10. Hence the check above. */
+	set_cad_params(symbolNum, static_cast<uint8_t>(config.modulation_params._lora.lora_sf) + 13, 10,
+				   LLCC68_Constants::CadExitMode::CAD_ONLY, 0);
+
+	IrqMask irqMask{};
+	irqMask.cad_done = 1;
+	irqMask.cad_detected = 1;
+	IrqMask no_mask{};
+
+	set_dio_irq_params(irqMask, irqMask, no_mask, no_mask);
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	set_cad();
+
+	return true;
+}
+
+bool LoRa::NRF_LLCC68::finish_transmit()
+{
+	const IrqStatus status = get_irq_status();
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	if (!status.tx_done)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return false;
+	}
+
+	stamp_packet(tx_time, get_payload_length());
+	capture_tx(nullptr, 0);
+
+	return true;
+}
+
+uint8_t LoRa::NRF_LLCC68::finish_receive(uint8_t *buffer, uint8_t max_size)
+{
+	const IrqStatus status = get_irq_status();
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	if (status.timeout)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return 0;
+	}
+	if (status.header_err)
+	{
+		last_error = ErrorCode::HEADER_ERROR;
+		return 0;
+	}
+	if (status.crc_err)
+	{
+		capture_rx(nullptr, 0, false);
+		last_error = ErrorCode::CRC_ERROR;
+		return 0;
+	}
+	if (!status.rx_done)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return 0;
+	}
+
+	uint8_t size = 0;
+	uint8_t start = 0;
+	get_rx_buffer_status(&size, &start);
+	stamp_packet(rx_time, size);
+	rx_time.preamble_us = 0;
+
+	const uint8_t received = size;
+	if (size > max_size)
+	{
+		size = max_size;
+	}
+	read_buffer(buffer, size, start);
+	/* A truncated copy isn't the frame on air, the capture reads it whole from the device */
+	capture_rx((size < received) ? nullptr : buffer, size, true);
+
+	return size;
+}
+
+bool LoRa::NRF_LLCC68::finish_cad()
+{
+	const IrqStatus status = get_irq_status();
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	if (!status.cad_done)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return false;
+	}
+
+	return status.cad_detected;
+}
+
+uint8_t LoRa::NRF_LLCC68::receive(uint8_t *buffer, uint8_t max_size, uint32_t rx_timeout, int32_t host_timeout_ms,
+								   const RxFilter *filter, bool *rejected)
+{
+	last_error = ErrorCode::NO_ERROR;
+
+	IrqMask irqMask{};
+	irqMask.rx_done = 1;
+	irqMask.preamble_detected = 1;
+	irqMask.header_valid = (filter != nullptr) ? 1 : 0;
+	irqMask.header_err = 1;
+	irqMask.crc_err = 1;
+	irqMask.timeout = 1;
+	IrqMask no_mask{};
+
+	set_dio_irq_params(irqMask, irqMask, no_mask, no_mask);
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	set_rx(static_cast<int32_t>(rx_timeout));
+
+	IrqStatus status;
+	int64_t preamble_us = 0;
+	bool header_checked = false; /* accept_header ran while the packet was being received */
+
+	while (true)
+	{
+		if (!wait_for_irq(pins.dio1, host_timeout_ms))
+		{
+			set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+			last_error = ErrorCode::TIMED_OUT;
+			return 0;
+		}
+
+		status = get_irq_status();
+
+		if (status.preamble_detected && !status.rx_done && !status.header_err && !status.crc_err && !status.timeout)
+		{
+			/* Only timestamped, keep waiting for the packet */
+			clear_irq_status(LLCC68_Constants::ClearIrqParam::PreambleDetected);
+			preamble_us = irq_time_us;
+			continue;
+		}
+
+		if ((filter != nullptr) && status.header_valid && !status.rx_done && !status.crc_err && !status.timeout)
+		{
+			clear_irq_status(LLCC68_Constants::ClearIrqParam::HeaderValid);
+			header_checked = true;
+			if (!accept_header(*filter))
+			{
+				/* Abort the foreign packet, the device stops receiving in standby */
+				set_standby(LLCC68_Constants::StandbyConfig::STDBY_RC);
+				clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+				filtered_packets++;
+				if (rejected != nullptr)
+				{
+					*rejected = true;
+				}
+				return 0;
+			}
+			continue;
+		}
+
+		break;
+	}
+
+	clear_irq_status(LLCC68_Constants::ClearIrqParam::All);
+
+	if (status.timeout)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return 0;
+	}
+	if (status.header_err)
+	{
+		last_error = ErrorCode::HEADER_ERROR;
+		return 0;
+	}
+	if (status.crc_err)
+	{
+		capture_rx(nullptr, 0, false);
+		last_error = ErrorCode::CRC_ERROR;
+		return 0;
+	}
+	if (!status.rx_done)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return 0;
+	}
+
+	uint8_t size = 0;
+	uint8_t start = 0;
+	get_rx_buffer_status(&size, &start);
+	stamp_packet(rx_time, size);
+	rx_time.preamble_us = preamble_us;
+
+	if ((filter != nullptr) && !header_checked)
+	{
+		/* RxDone came before the header could be checked, e.g. a very short packet or slow polling */
+		uint8_t head[sizeof(filter->value)];
+		bool accepted = (static_cast<uint16_t>(filter->offset) + filter->length <= size);
+
+		if (accepted)
+		{
+			read_buffer(head, filter->length, static_cast<uint8_t>(start + filter->offset));
+			accepted = filter_matches(*filter, head);
+		}
+
+		if (!accepted)
+		{
+			filtered_packets++;
+			if (rejected != nullptr)
+			{
+				*rejected = true;
+			}
+			return 0;
+		}
+	}
+
+	const uint8_t received = size;
+	if (size > max_size)
+	{
+		size = max_size;
+	}
+	read_buffer(buffer, size, start);
+	/* A truncated copy isn't the frame on air, the capture reads it whole from the device */
+	capture_rx((size < received) ? nullptr : buffer, size, true);
+
+	return size;
+}
+
+bool LoRa::NRF_LLCC68::accept_header(const RxFilter &filter)
+{
+	const uint8_t end = filter.offset + filter.length;
+	const uint32_t wait_us = get_time_to_payload_bytes(end);
+	uint8_t head[sizeof(filter.value)];
+	uint8_t length = 0;
+	uint8_t start = 0;
+
+	_device->delay(static_cast<int32_t>((wait_us + 999) / 1000));
+
+	get_rx_buffer_status(&length, &start);
+	read_buffer(head, filter.length, static_cast<uint8_t>(start + filter.offset));
+
+	return filter_matches(filter, head);
+}
+
 bool LoRa::NRF_LLCC68::init_llcc68()
 {
 	using LoRa::LLCC68_Constants;
 
-	if (config.packet_type != LLCC68_Constants::PacketType::LORA)
+	if ((config.packet_type == LLCC68_Constants::PacketType::GFSK) && (config.modulation_params._gfsk.bitrate == 0))
 	{
-		/* GFSK is not supported yet */
-		last_error = ErrorCode::UNSUPPORTED;
+		last_error = ErrorCode::INVALID_PARAMETER;
 		return false;
 	}
 
@@ -74,6 +503,29 @@ bool LoRa::NRF_LLCC68::init_llcc68()
 							   config.packet_params._lora.crcType,
 							   config.packet_params._lora.invertIq);
 	}
+	else
+	{
+		set_gfsk_modulation_params(config.modulation_params._gfsk.bitrate,
+								   config.modulation_params._gfsk.pulseShape,
+								   config.modulation_params._gfsk.bandwidth,
+								   config.modulation_params._gfsk.fdev);
+		set_gfsk_packet_params(config.packet_params._gfsk.preambleLength,
+							   config.packet_params._gfsk.preambleDetectorLength,
+							   config.packet_params._gfsk.syncWordLength,
+							   config.packet_params._gfsk.addrComp,
+							   config.packet_params._gfsk.packetType,
+							   config.packet_params._gfsk.payloadLength,
+							   config.packet_params._gfsk.crcType,
+							   config.packet_params._gfsk.whitening);
+	}
+
+	if (config.modulation_params._gfsk.bitrate != 0)
+	{
+		/* GFSK registers keep their values while LoRa is active */
+		write_gfsk_settings();
+	}
+
+	prepare_inactive_modem();
 
 	return true;
 }
\ No newline at end of file
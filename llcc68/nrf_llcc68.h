@@ -19,11 +19,35 @@ namespace LoRa
 			: LLCC68(pins, config, std::move(spi), std::move(io), std::move(device)) {};
 
 		virtual void send_packet(const uint8_t *packet, uint8_t size) override;
+		virtual void send_packet(const Segment *segments, uint8_t count) override;
+		virtual uint8_t receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms) override;
+		virtual uint8_t receive_packet(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, const RxFilter &filter) override;
+		virtual uint8_t receive_window(uint8_t *buffer, uint8_t max_size, uint8_t n_symbols) override;
+		virtual bool start_transmit(const Segment *segments, uint8_t count) override;
+		virtual bool start_receive(uint32_t timeout_ms) override;
+		virtual bool start_cad(LLCC68_Constants::CadSymbolNum symbolNum = LLCC68_Constants::CadSymbolNum::CAD_ON_2_SYMB) override;
+		virtual bool finish_transmit() override;
+		virtual uint8_t finish_receive(uint8_t *buffer, uint8_t max_size) override;
+		virtual bool finish_cad() override;
 		
 		virtual ~NRF_LLCC68();
 
 	protected:
 		virtual bool init_llcc68() override;
+
+		/**
+		 * @brief Starts single RX and collects the packet.
+		 * @param rx_timeout Device timeout in 15.625us steps.
+		 * @param host_timeout_ms How long to wait for the device to raise DIO1.
+		 * @param filter Optional. Checked on HeaderValid, foreign packets are aborted.
+		 * @param rejected Optional. Set if the packet was aborted by the filter.
+		 */
+		uint8_t receive(uint8_t *buffer, uint8_t max_size, uint32_t rx_timeout, int32_t host_timeout_ms,
+						const RxFilter *filter = nullptr, bool *rejected = nullptr);
+		/**
+		 * @brief Waits for the filtered bytes to arrive and reads them while the packet is still being received.
+		 */
+		bool accept_header(const RxFilter &filter);
 	};
 }
 
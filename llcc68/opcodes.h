@@ -62,6 +62,19 @@ namespace LoRa
 
 	};
 
+	/* Register addresses used by the driver */
+	enum REGISTER : uint16_t
+	{
+		WHITENING_INITIAL_MSB = 0x06B8, /* Only bit 0 belongs to the seed */
+		WHITENING_INITIAL_LSB = 0x06B9,
+		CRC_INITIAL = 0x06BC,
+		CRC_POLYNOMIAL = 0x06BE,
+		SYNC_WORD = 0x06C0, /* 8 bytes */
+		NODE_ADDRESS = 0x06CD,
+		BROADCAST_ADDRESS = 0x06CE,
+
+	};
+
 	typedef struct
 	{
 		uint8_t nss;	// chip select
@@ -80,16 +93,19 @@ namespace LoRa
 		bool use_TCXO;
 		LLCC68_Constants::Enable use_DIO2_as_rf_switch_ctrl;
 
-		LLCC68_Constants::PacketType packet_type; /* Only LoRa is supported as of now */
+		LLCC68_Constants::PacketType packet_type; /* Active modem after init. Params of both modems are kept to switch at runtime. */
 		int8_t tx_power;
 
-		union
+		struct
 		{
 			struct
 			{
-				int32_t not_used;
+				uint32_t bitrate; /* bps, 0 if GFSK is not used */
+				LLCC68_Constants::PulseShape pulseShape;
+				LLCC68_Constants::GFSK_BW bandwidth;
+				uint32_t fdev; /* Frequency deviation in Hz */
 
-			} _gfsk; /* FSK is not supported yet */
+			} _gfsk;
 
 			struct
 			{
@@ -102,11 +118,18 @@ namespace LoRa
 
 		} modulation_params;
 
-		union
+		struct
 		{
 			struct
 			{
-				int32_t not_used;
+				uint16_t preambleLength; /* In bits */
+				LLCC68_Constants::PreambleDetector preambleDetectorLength;
+				uint8_t syncWordLength; /* In bits, at most 64 */
+				LLCC68_Constants::AddrComp addrComp;
+				LLCC68_Constants::GFSK_PacketType packetType;
+				uint8_t payloadLength;
+				LLCC68_Constants::GFSK_CRC_Type crcType;
+				LLCC68_Constants::Whitening whitening;
 
 			} _gfsk;
 
@@ -122,6 +145,17 @@ namespace LoRa
 
 		} packet_params;
 
+		struct
+		{
+			uint8_t syncWord[8]; /* First syncWordLength bits are used */
+			uint16_t whiteningSeed; /* 9 bits */
+			uint16_t crcInit;
+			uint16_t crcPoly;
+			uint8_t nodeAddress;
+			uint8_t broadcastAddress;
+
+		} gfsk_settings;
+
 		struct
 		{
 			uint8_t paDutyCycle;
@@ -0,0 +1,279 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "pcap_writer.h"
+#include <cstdio>
+#include <cstring>
+
+using LoRa::Pcap_Writer;
+
+static_assert((Pcap_Writer::queue_capacity & (Pcap_Writer::queue_capacity - 1)) == 0, "queue_capacity must be a power of two");
+
+namespace
+{
+	/* pcapng block types and options */
+	constexpr uint32_t section_header_block = 0x0A0D0D0A;
+	constexpr uint32_t interface_description_block = 0x00000001;
+	constexpr uint32_t enhanced_packet_block = 0x00000006;
+	constexpr uint16_t opt_endofopt = 0;
+	constexpr uint16_t opt_comment = 1;
+	constexpr uint16_t epb_flags = 2;
+	constexpr uint32_t flag_inbound = 0x00000001;
+	constexpr uint32_t flag_outbound = 0x00000002;
+	constexpr uint32_t flag_crc_error = 0x01000000;
+
+	/* LoRaTap version 0: version, padding, length, frequency, bandwidth, SF, 3 RSSI, SNR, sync word */
+	constexpr uint8_t loratap_size = 15;
+	/* LoRaTap RSSI is dBm + 139 */
+	constexpr int16_t loratap_rssi_offset = 139;
+
+	/* pcapng fields in little endian, LoRaTap fields in big endian */
+	uint8_t *put_u16_le(uint8_t *p, uint16_t value)
+	{
+		p[0] = static_cast<uint8_t>(value);
+		p[1] = static_cast<uint8_t>(value >> 8);
+		return p + 2;
+	}
+
+	uint8_t *put_u32_le(uint8_t *p, uint32_t value)
+	{
+		p = put_u16_le(p, static_cast<uint16_t>(value));
+		return put_u16_le(p, static_cast<uint16_t>(value >> 16));
+	}
+
+	uint8_t *put_u32_be(uint8_t *p, uint32_t value)
+	{
+		p[0] = static_cast<uint8_t>(value >> 24);
+		p[1] = static_cast<uint8_t>(value >> 16);
+		p[2] = static_cast<uint8_t>(value >> 8);
+		p[3] = static_cast<uint8_t>(value);
+		return p + 4;
+	}
+
+	uint8_t *put_padding(uint8_t *p, size_t size)
+	{
+		while (size++ % 4 != 0)
+		{
+			*p++ = 0;
+		}
+		return p;
+	}
+
+	uint8_t to_loratap_rssi(int16_t rssi)
+	{
+		const int16_t value = static_cast<int16_t>(rssi + loratap_rssi_offset);
+		return static_cast<uint8_t>((value < 0) ? 0 : ((value > 255) ? 255 : value));
+	}
+}
+
+Pcap_Writer::Pcap_Writer(std::ostream &out, int64_t epoch_us, uint8_t sync_word)
+	: out{out}, epoch_us{epoch_us}, sync_word{sync_word}, enqueue_pos{0}, dequeue_pos{0}, signal{0}, running{true}, written{0}, dropped{0}, skipped{0}
+{
+	for (size_t i = 0; i < queue_capacity; i++)
+	{
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	write_header();
+	worker = std::thread(&Pcap_Writer::run, this);
+}
+
+Pcap_Writer::~Pcap_Writer()
+{
+	running.store(false, std::memory_order_release);
+	signal.fetch_add(1, std::memory_order_release);
+	signal.notify_one();
+
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+void LoRa::Pcap_Writer::capture(const CapturedFrame &frame)
+{
+	if (frame.packet_type != LLCC68_Constants::PacketType::LORA)
+	{
+		skipped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	Cell *cell;
+
+	/* Bounded MPMC ring (D. Vyukov), as in Radio_Executor */
+	while (true)
+	{
+		cell = &cells[pos & (queue_capacity - 1)];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+		if (diff == 0)
+		{
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->record.frame = frame;
+	cell->record.frame.payload = nullptr;
+	std::memcpy(cell->record.data, frame.payload, frame.size);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+
+	signal.fetch_add(1, std::memory_order_release);
+	signal.notify_one();
+}
+
+bool LoRa::Pcap_Writer::try_pop(Record &record)
+{
+	Cell &cell = cells[dequeue_pos & (queue_capacity - 1)];
+
+	if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1)
+	{
+		return false; /* Empty, or the producer hasn't finished writing the cell yet */
+	}
+
+	record.frame = cell.record.frame;
+	std::memcpy(record.data, cell.record.data, cell.record.frame.size);
+	record.frame.payload = record.data;
+	cell.sequence.store(dequeue_pos + queue_capacity, std::memory_order_release);
+	dequeue_pos++;
+
+	return true;
+}
+
+void LoRa::Pcap_Writer::write_header()
+{
+	uint8_t block[28 + 20];
+	uint8_t *p = block;
+
+	p = put_u32_le(p, section_header_block);
+	p = put_u32_le(p, 28);
+	p = put_u32_le(p, 0x1A2B3C4D); /* Byte order magic */
+	p = put_u16_le(p, 1);		   /* Version 1.0 */
+	p = put_u16_le(p, 0);
+	p = put_u32_le(p, 0xFFFFFFFF); /* Section length unknown */
+	p = put_u32_le(p, 0xFFFFFFFF);
+	p = put_u32_le(p, 28);
+
+	/* Timestamps in microseconds, the default resolution */
+	p = put_u32_le(p, interface_description_block);
+	p = put_u32_le(p, 20);
+	p = put_u16_le(p, linktype_loratap);
+	p = put_u16_le(p, 0);
+	p = put_u32_le(p, 0); /* No snap length limit */
+	p = put_u32_le(p, 20);
+
+	out.write(reinterpret_cast<const char *>(block), p - block);
+	out.flush();
+}
+
+void LoRa::Pcap_Writer::write_record(const Record &record)
+{
+	const CapturedFrame &frame = record.frame;
+	uint8_t block[32 + loratap_size + 255 + 3 + 8 + 4 + 16 + 4];
+	char comment[16];
+	const int comment_size = std::snprintf(comment, sizeof(comment), "CR 4/%u", static_cast<unsigned>(frame.cr) + 4);
+	const uint32_t captured = loratap_size + frame.size;
+	const uint64_t timestamp = static_cast<uint64_t>(epoch_us + frame.start_us);
+	uint32_t flags = frame.tx ? flag_outbound : flag_inbound;
+
+	if (!frame.crc_ok)
+	{
+		flags |= flag_crc_error;
+	}
+
+	uint8_t *p = block + 8; /* Type and length come last */
+
+	p = put_u32_le(p, 0); /* Interface */
+	p = put_u32_le(p, static_cast<uint32_t>(timestamp >> 32));
+	p = put_u32_le(p, static_cast<uint32_t>(timestamp));
+	p = put_u32_le(p, captured);
+	p = put_u32_le(p, captured);
+
+	*p++ = 0; /* LoRaTap version 0 */
+	*p++ = 0;
+	*p++ = 0;
+	*p++ = loratap_size;
+	p = put_u32_be(p, frame.frequency);
+	*p++ = (frame.bw == LLCC68_Constants::BW::LORA_BW_500) ? 4 : ((frame.bw == LLCC68_Constants::BW::LORA_BW_250) ? 2 : 1); /* 125 kHz steps */
+	*p++ = static_cast<uint8_t>(frame.sf);
+	*p++ = frame.tx ? 0 : to_loratap_rssi(frame.status.rssi);		 /* Packet */
+	*p++ = 0;														 /* Max, not available */
+	*p++ = frame.tx ? 0 : to_loratap_rssi(frame.status.signal_rssi); /* Current, taken as the despread signal */
+	*p++ = static_cast<uint8_t>(frame.tx ? 0 : frame.status.snr * 4); /* Quarter dB */
+	*p++ = sync_word;
+	std::memcpy(p, frame.payload, frame.size);
+	p = put_padding(p + frame.size, captured);
+
+	p = put_u16_le(p, epb_flags);
+	p = put_u16_le(p, 4);
+	p = put_u32_le(p, flags);
+	if (comment_size > 0)
+	{
+		p = put_u16_le(p, opt_comment);
+		p = put_u16_le(p, static_cast<uint16_t>(comment_size));
+		std::memcpy(p, comment, comment_size);
+		p = put_padding(p + comment_size, comment_size);
+	}
+	p = put_u16_le(p, opt_endofopt);
+	p = put_u16_le(p, 0);
+
+	const uint32_t total = static_cast<uint32_t>(p - block) + 4;
+	p = put_u32_le(p, total);
+	put_u32_le(block, enhanced_packet_block);
+	put_u32_le(block + 4, total);
+
+	out.write(reinterpret_cast<const char *>(block), total);
+	written.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LoRa::Pcap_Writer::run()
+{
+	Record record;
+
+	while (true)
+	{
+		const uint32_t observed = signal.load(std::memory_order_acquire);
+		bool wrote = false;
+
+		while (try_pop(record))
+		{
+			write_record(record);
+			wrote = true;
+		}
+		/* One flush per batch, so a reader sees frames while the capture is running */
+		if (wrote)
+		{
+			out.flush();
+		}
+
+		if (!running.load(std::memory_order_acquire))
+		{
+			/* A producer may have claimed a cell without publishing it yet */
+			if (enqueue_pos.load(std::memory_order_acquire) == dequeue_pos)
+			{
+				return;
+			}
+			std::this_thread::yield();
+			continue;
+		}
+
+		signal.wait(observed, std::memory_order_acquire);
+	}
+}
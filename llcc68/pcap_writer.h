@@ -0,0 +1,94 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Streams captured frames as pcapng with a LoRaTap link-layer header. Requires a hosted platform with std::thread and C++20.
+ */
+
+#ifndef __LLCC68_PCAP_WRITER_H__
+#define __LLCC68_PCAP_WRITER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Capture sink that queues frames in a bounded lock-free multi-producer queue and writes
+	 * them on its own thread, so the radio loop never waits for the stream. Frames arriving while the
+	 * queue is full are dropped and counted. Channel, SF, bandwidth and levels go in the 15 byte
+	 * LoRaTap version 0 header, direction and CRC errors in the packet flags, the coding rate in
+	 * the packet comment.
+	 * GFSK frames are skipped, LoRaTap can't describe them.
+	 */
+	class Pcap_Writer : public Capture_Sink
+	{
+	public:
+		static constexpr size_t queue_capacity = 256; /* Must be a power of two */
+		static constexpr uint16_t linktype_loratap = 270;
+
+		/**
+		 * @param out Opened in binary mode, must outlive the writer.
+		 * @param epoch_us Added to the device timestamps, e.g. the UNIX time of device time 0.
+		 * @param sync_word LoRaTap sync word field. The driver leaves the device default, 0x12 (private
+		 * network), pass the one in use if the sync word registers were changed.
+		 */
+		explicit Pcap_Writer(std::ostream &out, int64_t epoch_us = 0, uint8_t sync_word = 0x12);
+		/* Queued frames are written before the worker stops */
+		~Pcap_Writer();
+
+		Pcap_Writer(const Pcap_Writer &) = delete;
+		Pcap_Writer &operator=(const Pcap_Writer &) = delete;
+
+		virtual void capture(const CapturedFrame &frame) override;
+
+		inline uint64_t get_written_count() const { return written.load(std::memory_order_relaxed); }
+		/* Frames lost to a full queue */
+		inline uint64_t get_dropped_count() const { return dropped.load(std::memory_order_relaxed); }
+		/* GFSK frames */
+		inline uint64_t get_skipped_count() const { return skipped.load(std::memory_order_relaxed); }
+
+	private:
+		typedef struct
+		{
+			CapturedFrame frame; /* payload points to data once popped */
+			uint8_t data[255];
+
+		} Record;
+
+		typedef struct
+		{
+			std::atomic<size_t> sequence;
+			Record record;
+
+		} Cell;
+
+		bool try_pop(Record &record);
+		/* Section header and interface description blocks */
+		void write_header();
+		/* Enhanced packet block */
+		void write_record(const Record &record);
+		void run();
+
+		std::ostream &out;
+		int64_t epoch_us;
+		uint8_t sync_word;
+		Cell cells[queue_capacity];
+		alignas(64) std::atomic<size_t> enqueue_pos;
+		alignas(64) size_t dequeue_pos; /* Only touched by the worker */
+		std::atomic<uint32_t> signal;	/* Bumped on every push, the worker waits on it when idle */
+		std::atomic<bool> running;
+		std::atomic<uint64_t> written;
+		std::atomic<uint64_t> dropped;
+		std::atomic<uint64_t> skipped;
+		std::thread worker;
+	};
+}
+
+#endif // __LLCC68_PCAP_WRITER_H__
@@ -0,0 +1,166 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "radio_executor.h"
+#include <cstring>
+
+using LoRa::Radio_Executor;
+
+static_assert((Radio_Executor::queue_capacity & (Radio_Executor::queue_capacity - 1)) == 0, "queue_capacity must be a power of two");
+
+Radio_Executor::Radio_Executor(LLCC68 &radio)
+	: radio{radio}, enqueue_pos{0}, dequeue_pos{0}, signal{0}, running{true}, executed{0}
+{
+	for (size_t i = 0; i < queue_capacity; i++)
+	{
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	worker = std::thread(&Radio_Executor::run, this);
+}
+
+Radio_Executor::~Radio_Executor()
+{
+	running.store(false, std::memory_order_release);
+	signal.fetch_add(1, std::memory_order_release);
+	signal.notify_one();
+
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+bool LoRa::Radio_Executor::post(Task task)
+{
+	return try_push(task);
+}
+
+std::future<LoRa::ErrorCode> LoRa::Radio_Executor::send(const uint8_t *packet, uint8_t size)
+{
+	auto copy = std::make_shared<Packet>();
+	std::memcpy(copy->data, packet, size);
+	copy->size = size;
+
+	return submit([copy](LLCC68 &radio)
+				  {
+					  radio.clear_last_error();
+					  radio.send_packet(copy->data, copy->size);
+					  return radio.get_last_error(); });
+}
+
+bool LoRa::Radio_Executor::send(const uint8_t *packet, uint8_t size, std::function<void(ErrorCode)> callback)
+{
+	auto copy = std::make_shared<Packet>();
+	std::memcpy(copy->data, packet, size);
+	copy->size = size;
+
+	Task task = [copy, callback = std::move(callback)](LLCC68 &radio)
+	{
+		radio.clear_last_error();
+		radio.send_packet(copy->data, copy->size);
+		if (callback)
+		{
+			callback(radio.get_last_error());
+		}
+	};
+
+	return try_push(task);
+}
+
+bool LoRa::Radio_Executor::try_push(Task &task)
+{
+	size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	Cell *cell;
+
+	/* Bounded MPMC ring (D. Vyukov), each cell's sequence tells whose turn it is */
+	while (true)
+	{
+		cell = &cells[pos & (queue_capacity - 1)];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+		if (diff == 0)
+		{
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false; /* Full */
+		}
+		else
+		{
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->task = std::move(task);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+
+	signal.fetch_add(1, std::memory_order_release);
+	signal.notify_one();
+
+	return true;
+}
+
+void LoRa::Radio_Executor::push(Task task)
+{
+	while (!try_push(task))
+	{
+		std::this_thread::yield();
+	}
+}
+
+bool LoRa::Radio_Executor::try_pop(Task &task)
+{
+	Cell &cell = cells[dequeue_pos & (queue_capacity - 1)];
+
+	if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1)
+	{
+		return false; /* Empty, or the producer hasn't finished writing the cell yet */
+	}
+
+	task = std::move(cell.task);
+	cell.task = nullptr;
+	cell.sequence.store(dequeue_pos + queue_capacity, std::memory_order_release);
+	dequeue_pos++;
+
+	return true;
+}
+
+void LoRa::Radio_Executor::run()
+{
+	Task task;
+
+	while (true)
+	{
+		const uint32_t observed = signal.load(std::memory_order_acquire);
+
+		while (try_pop(task))
+		{
+			task(radio);
+			task = nullptr;
+			executed.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (!running.load(std::memory_order_acquire))
+		{
+			/* A producer may have claimed a cell without publishing it yet */
+			if (enqueue_pos.load(std::memory_order_acquire) == dequeue_pos)
+			{
+				return;
+			}
+			std::this_thread::yield();
+			continue;
+		}
+
+		signal.wait(observed, std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,123 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Runs all radio operations on one thread. Requires a hosted platform with std::thread and C++20.
+ */
+
+#ifndef __LLCC68_RADIO_EXECUTOR_H__
+#define __LLCC68_RADIO_EXECUTOR_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Owns the radio on a worker thread. Any thread may submit requests through a bounded
+	 * lock-free multi-producer queue; requests are executed one at a time in submission order,
+	 * so commands never interleave on the bus and no mutex is taken around radio calls.
+	 */
+	class Radio_Executor
+	{
+	public:
+		static constexpr size_t queue_capacity = 64; /* Must be a power of two */
+
+		typedef std::function<void(LLCC68 &)> Task;
+
+		explicit Radio_Executor(LLCC68 &radio);
+		/* Pending requests are executed before the worker stops */
+		~Radio_Executor();
+
+		Radio_Executor(const Radio_Executor &) = delete;
+		Radio_Executor &operator=(const Radio_Executor &) = delete;
+
+		/**
+		 * @brief Queues a task without waiting for it.
+		 * @return false if the queue is full.
+		 */
+		bool post(Task task);
+
+		/**
+		 * @brief Queues a callable taking LLCC68 & and returns a future of its result.
+		 * Waits for space if the queue is full.
+		 */
+		template <typename F>
+		auto submit(F &&f) -> std::future<std::invoke_result_t<F, LLCC68 &>>
+		{
+			typedef std::invoke_result_t<F, LLCC68 &> Result;
+
+			auto promise = std::make_shared<std::promise<Result>>();
+			auto future = promise->get_future();
+
+			push([promise, f = std::forward<F>(f)](LLCC68 &radio) mutable
+				 {
+					 if constexpr (std::is_void_v<Result>)
+					 {
+						 f(radio);
+						 promise->set_value();
+					 }
+					 else
+					 {
+						 promise->set_value(f(radio));
+					 }
+				 });
+
+			return future;
+		}
+
+		/**
+		 * @brief Copies the packet and sends it on the radio thread.
+		 * @return Future of the error this send reported, NO_ERROR or TIMED_OUT.
+		 */
+		std::future<ErrorCode> send(const uint8_t *packet, uint8_t size);
+		/**
+		 * @brief Same as above, but calls back on the radio thread instead of using a future.
+		 */
+		bool send(const uint8_t *packet, uint8_t size, std::function<void(ErrorCode)> callback);
+
+		/* Requests executed so far */
+		inline uint64_t get_executed_count() const { return executed.load(std::memory_order_relaxed); }
+
+	private:
+		typedef struct
+		{
+			std::atomic<size_t> sequence;
+			Task task;
+
+		} Cell;
+
+		typedef struct
+		{
+			uint8_t data[255];
+			uint8_t size;
+
+		} Packet;
+
+		bool try_push(Task &task);
+		/* Waits for space */
+		void push(Task task);
+		bool try_pop(Task &task);
+		void run();
+
+		LLCC68 &radio;
+		Cell cells[queue_capacity];
+		alignas(64) std::atomic<size_t> enqueue_pos;
+		alignas(64) size_t dequeue_pos; /* Only touched by the worker */
+		std::atomic<uint32_t> signal;	/* Bumped on every push, the worker waits on it when idle */
+		std::atomic<bool> running;
+		std::atomic<uint64_t> executed;
+		std::thread worker;
+	};
+}
+
+#endif // __LLCC68_RADIO_EXECUTOR_H__
@@ -0,0 +1,188 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "secure_frame.h"
+#include <cstring>
+
+using LoRa::Secure_Frame;
+
+namespace
+{
+	/* Separate keys for encryption and MIC: K_label = AES_K(label || 0^120) */
+	LoRa::AES128 derive_key(const uint8_t *key, uint8_t label)
+	{
+		LoRa::AES128 master(key);
+		uint8_t block[LoRa::AES128::block_size] = {label};
+
+		master.encrypt_block(block, block);
+		return LoRa::AES128(block);
+	}
+}
+
+Secure_Frame::Secure_Frame(LLCC68 &radio, const uint8_t *key, uint16_t address, uint32_t frame_counter)
+	: radio{radio}, enc{derive_key(key, 0x01)}, mac{derive_key(key, 0x02)}, cmac{mac},
+	  address{address}, frame_counter{frame_counter}, peers{}, n_accepted{0}, last_error{ErrorCode::NO_ERROR}
+{
+}
+
+bool LoRa::Secure_Frame::send(uint8_t *payload, uint8_t size)
+{
+	if ((size > max_payload_size) || (frame_counter == UINT32_MAX))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	uint8_t header[header_size];
+	uint8_t mic[AES128::block_size];
+
+	header[0] = static_cast<uint8_t>(address);
+	header[1] = static_cast<uint8_t>(address >> 8);
+	header[2] = static_cast<uint8_t>(frame_counter);
+	header[3] = static_cast<uint8_t>(frame_counter >> 8);
+	header[4] = static_cast<uint8_t>(frame_counter >> 16);
+	header[5] = static_cast<uint8_t>(frame_counter >> 24);
+
+	crypt(address, frame_counter, payload, size);
+	compute_mic(header, payload, size, mic);
+	frame_counter++;
+
+	const Segment segments[] = {{header, header_size}, {payload, size}, {mic, mic_size}};
+	radio.send_packet(segments, 3);
+
+	return true;
+}
+
+uint8_t LoRa::Secure_Frame::receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint16_t *sender)
+{
+	const uint8_t size = radio.receive_packet(buffer, max_size, timeout_ms);
+
+	if (size == 0)
+	{
+		last_error = radio.get_last_error();
+		return 0;
+	}
+
+	return open(buffer, size, sender);
+}
+
+uint8_t LoRa::Secure_Frame::open(uint8_t *frame, uint8_t size, uint16_t *sender)
+{
+	if (size < overhead)
+	{
+		last_error = ErrorCode::AUTHENTICATION_FAILED;
+		return 0;
+	}
+
+	const uint8_t payload_size = size - overhead;
+	const uint16_t from = static_cast<uint16_t>(frame[0] | (frame[1] << 8));
+	const uint32_t counter = static_cast<uint32_t>(frame[2]) | (static_cast<uint32_t>(frame[3]) << 8) |
+							 (static_cast<uint32_t>(frame[4]) << 16) | (static_cast<uint32_t>(frame[5]) << 24);
+	uint8_t *payload = frame + header_size;
+	uint8_t mic[AES128::block_size];
+
+	compute_mic(frame, payload, payload_size, mic);
+
+	/* Constant time compare */
+	uint8_t diff = 0;
+	for (uint8_t i = 0; i < mic_size; i++)
+	{
+		diff |= mic[i] ^ payload[payload_size + i];
+	}
+	if (diff != 0)
+	{
+		last_error = ErrorCode::AUTHENTICATION_FAILED;
+		return 0;
+	}
+
+	/* Only authentic frames may create or advance a peer entry */
+	Peer *peer = find_peer(from);
+	if (peer->valid && (counter <= peer->last_counter))
+	{
+		last_error = ErrorCode::REPLAYED;
+		return 0;
+	}
+	peer->valid = true;
+	peer->last_counter = counter;
+	peer->last_used = ++n_accepted;
+
+	crypt(from, counter, payload, payload_size);
+	std::memmove(frame, payload, payload_size);
+
+	if (sender != nullptr)
+	{
+		*sender = from;
+	}
+
+	return payload_size;
+}
+
+void LoRa::Secure_Frame::crypt(uint16_t address, uint32_t counter, uint8_t *data, uint8_t size) const
+{
+	constexpr uint8_t batch = 4;
+	uint8_t blocks[batch * AES128::block_size];
+	uint8_t block_index = 0;
+
+	while (size > 0)
+	{
+		const uint8_t n_blocks = static_cast<uint8_t>((size + AES128::block_size - 1) / AES128::block_size);
+		const uint8_t n = (n_blocks < batch) ? n_blocks : batch;
+
+		/* Counter block: [0x01][address 2][frame counter 4][0 x 8][block index] */
+		std::memset(blocks, 0, sizeof(blocks));
+		for (uint8_t b = 0; b < n; b++)
+		{
+			uint8_t *block = &blocks[b * AES128::block_size];
+			block[0] = 0x01;
+			block[1] = static_cast<uint8_t>(address);
+			block[2] = static_cast<uint8_t>(address >> 8);
+			block[3] = static_cast<uint8_t>(counter);
+			block[4] = static_cast<uint8_t>(counter >> 8);
+			block[5] = static_cast<uint8_t>(counter >> 16);
+			block[6] = static_cast<uint8_t>(counter >> 24);
+			block[15] = block_index++;
+		}
+
+		enc.encrypt_blocks(blocks, blocks, n);
+
+		const uint8_t chunk = (size < n * AES128::block_size) ? size : static_cast<uint8_t>(n * AES128::block_size);
+		for (uint8_t i = 0; i < chunk; i++)
+		{
+			data[i] ^= blocks[i];
+		}
+		data += chunk;
+		size -= chunk;
+	}
+}
+
+void LoRa::Secure_Frame::compute_mic(const uint8_t *header, const uint8_t *ciphertext, uint8_t size, uint8_t *mic) const
+{
+	const Segment segments[] = {{header, header_size}, {ciphertext, size}};
+	cmac.compute(segments, 2, mic);
+}
+
+LoRa::Secure_Frame::Peer *LoRa::Secure_Frame::find_peer(uint16_t address)
+{
+	Peer *oldest = &peers[0];
+
+	for (uint8_t i = 0; i < max_peers; i++)
+	{
+		if (peers[i].valid && (peers[i].address == address))
+		{
+			return &peers[i];
+		}
+		if (!peers[i].valid || (oldest->valid && (peers[i].last_used < oldest->last_used)))
+		{
+			oldest = &peers[i];
+		}
+	}
+
+	/* Evicting the least recently heard peer forgets its counter, keep max_peers above the network size */
+	*oldest = Peer{};
+	oldest->address = address;
+	return oldest;
+}
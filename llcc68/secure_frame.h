@@ -0,0 +1,89 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Encrypted and authenticated frames on top of LLCC68.
+ * Frame layout: [address 2][frame counter 4][AES-CTR ciphertext][CMAC 4], little endian fields.
+ */
+
+#ifndef __LLCC68_SECURE_FRAME_H__
+#define __LLCC68_SECURE_FRAME_H__
+
+#include <cstdint>
+
+#include "aes.h"
+#include "llcc68.h"
+
+namespace LoRa
+{
+	class Secure_Frame
+	{
+	public:
+		static constexpr uint8_t header_size = 6;
+		static constexpr uint8_t mic_size = 4;
+		static constexpr uint8_t overhead = header_size + mic_size;
+		static constexpr uint8_t max_payload_size = 255 - overhead;
+		/* Senders tracked for replay protection */
+		static constexpr uint8_t max_peers = 16;
+
+		/**
+		 * @param key Network key, 16 bytes. Encryption and MIC keys are derived from it.
+		 * @param address Address of this node, part of the nonce so nodes sharing a key never reuse keystream.
+		 * @param frame_counter First counter to use. Persist get_frame_counter() across resets.
+		 */
+		Secure_Frame(LLCC68 &radio, const uint8_t *key, uint16_t address, uint32_t frame_counter = 0);
+
+		/* cmac refers to mac, a copy would point into the source object. Also disables moves. */
+		Secure_Frame(const Secure_Frame &) = delete;
+		Secure_Frame &operator=(const Secure_Frame &) = delete;
+
+		/**
+		 * @brief Encrypts the payload in place and sends it with header and MIC, without copying.
+		 * The payload is left encrypted.
+		 * @return false if the payload is too large or the frame counter is exhausted.
+		 */
+		bool send(uint8_t *payload, uint8_t size);
+		/**
+		 * @brief Receives a frame, see open().
+		 * @param buffer Must hold the whole frame, i.e. payload + overhead bytes.
+		 */
+		uint8_t receive(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms, uint16_t *sender = nullptr);
+		/**
+		 * @brief Verifies, replay checks and decrypts a received frame in place.
+		 * The payload is moved to the start of the frame.
+		 * @return Payload size, 0 if the frame is rejected. Check get_last_error().
+		 */
+		uint8_t open(uint8_t *frame, uint8_t size, uint16_t *sender = nullptr);
+
+		inline uint32_t get_frame_counter() const { return frame_counter; }
+		inline ErrorCode get_last_error() const { return last_error; }
+
+	private:
+		typedef struct
+		{
+			uint16_t address;
+			uint32_t last_counter;
+			uint32_t last_used; /* For eviction */
+			bool valid;
+
+		} Peer;
+
+		void crypt(uint16_t address, uint32_t counter, uint8_t *data, uint8_t size) const;
+		void compute_mic(const uint8_t *header, const uint8_t *ciphertext, uint8_t size, uint8_t *mic) const;
+		/* Creates the entry, evicting the least recently heard peer if needed */
+		Peer *find_peer(uint16_t address);
+
+		LLCC68 &radio;
+		AES128 enc;
+		AES128 mac;
+		AES128_CMAC cmac;
+		uint16_t address;
+		uint32_t frame_counter;
+		Peer peers[max_peers];
+		uint32_t n_accepted;
+		ErrorCode last_error;
+	};
+}
+
+#endif // __LLCC68_SECURE_FRAME_H__
@@ -0,0 +1,222 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "tdma.h"
+
+using LoRa::TDMA_Scheduler;
+
+TDMA_Scheduler::TDMA_Scheduler(LLCC68 &radio, uint32_t slot_us, uint8_t n_slots, uint8_t own_slot)
+	: radio{radio}, slot_us{slot_us}, n_slots{n_slots}, own_slot{own_slot}, synchronized{false}, anchor_us{0},
+	  frame_q8{(static_cast<int64_t>(slot_us) * n_slots) << 8}, jitter_us{0}, guard_us{min_guard_us}, tx_latency_us{0},
+	  last_error{ErrorCode::NO_ERROR}
+{
+}
+
+bool LoRa::TDMA_Scheduler::is_synchronized() const
+{
+	if (!synchronized)
+	{
+		return false;
+	}
+
+	const int64_t elapsed = radio.get_device().timestamp_us() - anchor_us;
+
+	return elapsed <= (static_cast<int64_t>(max_missed_beacons) + 1) * get_frame_length();
+}
+
+int64_t LoRa::TDMA_Scheduler::get_next_slot_start(uint8_t slot) const
+{
+	const int64_t frame_us = get_frame_length();
+	const int64_t offset = static_cast<int64_t>(slot) * slot_us;
+	const int64_t now = radio.get_device().timestamp_us();
+
+	int64_t frames = (now - anchor_us - offset) / frame_us;
+	int64_t start = anchor_us + offset + ((frames * frame_q8) >> 8);
+
+	while (start < now)
+	{
+		frames++;
+		start = anchor_us + offset + ((frames * frame_q8) >> 8);
+	}
+
+	return start;
+}
+
+bool LoRa::TDMA_Scheduler::send_beacon(const uint8_t *payload, uint8_t size)
+{
+	if (radio.get_time_on_air(size) + guard_us > slot_us)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	if (!synchronized)
+	{
+		const int64_t now = radio.get_device().timestamp_us();
+		if (!transmit_at(now, payload, size))
+		{
+			return false;
+		}
+		anchor_us = radio.get_tx_time().start_us;
+		synchronized = true;
+		return true;
+	}
+
+	/* The coordinator owns the grid, its beacons are scheduled on it rather than moving it */
+	const int64_t target = get_next_slot_start(0);
+	if (!transmit_at(target, payload, size))
+	{
+		return false;
+	}
+
+	const int64_t frame_us = get_frame_length();
+	const int64_t frames = (target - anchor_us + frame_us / 2) / frame_us;
+	const int64_t error = radio.get_tx_time().start_us - target;
+	const uint32_t deviation = static_cast<uint32_t>((error < 0) ? -error : error);
+
+	jitter_us = jitter_us - (jitter_us >> 3) + (deviation >> 3);
+	guard_us = min_guard_us + 4 * jitter_us;
+	anchor_us += (frames * frame_q8) >> 8;
+
+	return true;
+}
+
+uint8_t LoRa::TDMA_Scheduler::receive_beacon(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms)
+{
+	uint8_t size;
+
+	if (is_synchronized())
+	{
+		const auto &lora = radio.get_config().modulation_params._lora;
+		const uint32_t symbol_us = LLCC68::calculate_symbol_time(lora.lora_sf, lora.bandwidth);
+		/* The window only has to catch the preamble, the modem then stays in RX until the beacon is received */
+		const uint32_t n_symbols = (2 * guard_us + symbol_us - 1) / symbol_us + preamble_detect_symbols;
+		const int64_t expected = get_next_slot_start(0);
+
+		wait_until(expected - guard_us);
+		size = radio.receive_window(buffer, max_size, static_cast<uint8_t>((n_symbols < 248) ? n_symbols : 248));
+	}
+	else
+	{
+		synchronized = false;
+		size = radio.receive_packet(buffer, max_size, timeout_ms);
+	}
+
+	if ((size == 0) || (radio.get_rx_time().end_us == 0))
+	{
+		last_error = radio.get_last_error();
+		return 0;
+	}
+
+	update_grid(radio.get_rx_time().start_us);
+
+	return size;
+}
+
+bool LoRa::TDMA_Scheduler::send(const uint8_t *packet, uint8_t size)
+{
+	if ((own_slot == 0) || (own_slot >= n_slots))
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	if (!is_synchronized())
+	{
+		last_error = ErrorCode::NOT_SYNCHRONIZED;
+		return false;
+	}
+
+	/* Guard on both ends, the next slot's owner may be early */
+	if (guard_us + radio.get_time_on_air(size) + guard_us > slot_us)
+	{
+		last_error = ErrorCode::INVALID_PARAMETER;
+		return false;
+	}
+
+	const int64_t now = radio.get_device().timestamp_us();
+	int64_t target = get_next_slot_start(own_slot) + guard_us;
+
+	/* Still in time for the slot that has just started */
+	const int64_t previous = target - get_frame_length();
+	if (previous - tx_latency_us >= now)
+	{
+		target = previous;
+	}
+
+	return transmit_at(target, packet, size);
+}
+
+void LoRa::TDMA_Scheduler::update_grid(int64_t beacon_start_us)
+{
+	if (!synchronized)
+	{
+		anchor_us = beacon_start_us;
+		synchronized = true;
+		return;
+	}
+
+	const int64_t frame_us = get_frame_length();
+	const int64_t elapsed = beacon_start_us - anchor_us;
+	const int64_t frames = (elapsed + frame_us / 2) / frame_us;
+
+	if (frames <= 0)
+	{
+		return;
+	}
+
+	const int64_t error = elapsed - ((frames * frame_q8) >> 8);
+	const uint32_t deviation = static_cast<uint32_t>((error < 0) ? -error : error);
+
+	/* EWMAs with gain 1/8. The frame length absorbs clock drift, what's left is jitter. */
+	jitter_us = jitter_us - (jitter_us >> 3) + (deviation >> 3);
+	frame_q8 += ((error << 8) / frames) >> 3;
+	guard_us = min_guard_us + 4 * jitter_us;
+	anchor_us = beacon_start_us;
+}
+
+bool LoRa::TDMA_Scheduler::transmit_at(int64_t target_us, const uint8_t *packet, uint8_t size)
+{
+	wait_until(target_us - tx_latency_us);
+	radio.send_packet(packet, size);
+
+	const PacketTime &time = radio.get_tx_time();
+	if (time.end_us == 0)
+	{
+		last_error = ErrorCode::TIMED_OUT;
+		return false;
+	}
+
+	/* Command setup and PLL lock happen before the preamble, start that much earlier next time */
+	tx_latency_us += static_cast<int32_t>(time.start_us - target_us) / 8;
+	if (tx_latency_us < 0)
+	{
+		tx_latency_us = 0;
+	}
+	last_error = ErrorCode::NO_ERROR;
+
+	return true;
+}
+
+void LoRa::TDMA_Scheduler::wait_until(int64_t us)
+{
+	Device &device = radio.get_device();
+
+	while (true)
+	{
+		const int64_t remaining = us - device.timestamp_us();
+
+		if (remaining <= 0)
+		{
+			return;
+		}
+		if (remaining > 2000)
+		{
+			device.delay(static_cast<int32_t>(remaining / 1000) - 1);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Beacon synchronised TDMA on top of the LLCC68 driver.
+ */
+
+#ifndef __LLCC68_TDMA_H__
+#define __LLCC68_TDMA_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Slot grid anchored to beacons. Frames start with the beacon in slot 0, each node
+	 * transmits in its own slot. Beacon times are taken from the RxDone/TxDone edge minus time on air,
+	 * guard times follow the measured jitter and the frame length tracks the coordinator's clock.
+	 */
+	class TDMA_Scheduler
+	{
+	public:
+		/* Guard time never drops below this, one tick of a millisecond clock */
+		static constexpr uint32_t min_guard_us = 1000;
+		/* Beacons that may be missed before the grid is considered lost */
+		static constexpr uint8_t max_missed_beacons = 4;
+		/* Preamble symbols the modem needs before it stops the RX timer */
+		static constexpr uint8_t preamble_detect_symbols = 5;
+
+		/**
+		 * @param slot_us Slot length in microseconds.
+		 * @param n_slots Slots per frame, including the beacon slot.
+		 * @param own_slot Slot this node transmits in, 1 to n_slots - 1. Unused by the coordinator.
+		 */
+		TDMA_Scheduler(LLCC68 &radio, uint32_t slot_us, uint8_t n_slots, uint8_t own_slot);
+
+		/**
+		 * @brief Coordinator side. Sends a beacon at the start of the next frame, the first one right away.
+		 * @return false if the beacon doesn't fit in a slot or TX failed.
+		 */
+		bool send_beacon(const uint8_t *payload, uint8_t size);
+		/**
+		 * @brief Node side. Listens for up to timeout_ms if not synchronised, otherwise opens a window
+		 * of twice the guard time around the expected beacon, plus the time to detect its preamble.
+		 * Beacons must be LoRa.
+		 * @return Beacon size, 0 if missed.
+		 */
+		uint8_t receive_beacon(uint8_t *buffer, uint8_t max_size, uint32_t timeout_ms);
+		/**
+		 * @brief Sends the packet in the own slot of the current or next frame, one guard time into the slot.
+		 * @return false if not synchronised, the packet doesn't fit in the slot or TX failed.
+		 */
+		bool send(const uint8_t *packet, uint8_t size);
+
+		bool is_synchronized() const;
+		/**
+		 * @return Start of the given slot in the next frame that hasn't started it yet, microseconds on the Device clock.
+		 */
+		int64_t get_next_slot_start(uint8_t slot) const;
+		inline uint32_t get_guard_time() const { return guard_us; }
+		/* Mean absolute deviation of beacon arrivals from the grid, microseconds */
+		inline uint32_t get_jitter() const { return jitter_us; }
+		/* Frame length as measured from beacons, microseconds */
+		inline int64_t get_frame_length() const { return frame_q8 >> 8; }
+		inline ErrorCode get_last_error() const { return last_error; }
+
+	private:
+		/* Moves the grid to a new beacon and updates jitter, frame length and guard time */
+		void update_grid(int64_t beacon_start_us);
+		/* Sends with the TX start aligned to target_us, learning the setup latency */
+		bool transmit_at(int64_t target_us, const uint8_t *packet, uint8_t size);
+		/* Sleeps in milliseconds and spins the last one */
+		void wait_until(int64_t us);
+
+		LLCC68 &radio;
+		uint32_t slot_us;
+		uint8_t n_slots;
+		uint8_t own_slot;
+		bool synchronized;
+		int64_t anchor_us;	   /* Start of the last beacon */
+		int64_t frame_q8;	   /* Frame length in 1/256 us */
+		uint32_t jitter_us;
+		uint32_t guard_us;
+		int32_t tx_latency_us; /* From transmit_at() until the preamble starts */
+		ErrorCode last_error;
+	};
+}
+
+#endif // __LLCC68_TDMA_H__
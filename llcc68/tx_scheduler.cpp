@@ -0,0 +1,169 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "tx_scheduler.h"
+#include <cstring>
+
+using LoRa::TX_Scheduler;
+
+TX_Scheduler::TX_Scheduler(LLCC68 &radio)
+	: radio{radio}, classes{}, round_robin{0}
+{
+	for (uint8_t i = 0; i < max_classes; i++)
+	{
+		classes[i].strict = (i == 0);
+		classes[i].weight = 1;
+	}
+}
+
+bool LoRa::TX_Scheduler::configure_class(uint8_t traffic_class, bool strict, uint8_t weight)
+{
+	if ((traffic_class >= max_classes) || (!strict && (weight == 0)))
+	{
+		return false;
+	}
+
+	classes[traffic_class].strict = strict;
+	classes[traffic_class].weight = weight;
+	classes[traffic_class].deficit = 0;
+
+	return true;
+}
+
+bool LoRa::TX_Scheduler::enqueue(uint8_t traffic_class, const uint8_t *frame, uint8_t size)
+{
+	if ((traffic_class >= max_classes) || (size == 0))
+	{
+		return false;
+	}
+
+	TrafficClass &tc = classes[traffic_class];
+
+	if (tc.count == queue_depth)
+	{
+		tc.metrics.dropped++;
+		return false;
+	}
+
+	Frame &slot = tc.frames[(tc.head + tc.count) % queue_depth];
+	std::memcpy(slot.data, frame, size);
+	slot.size = size;
+	slot.enqueued_at = radio.get_device().timestamp_64();
+
+	tc.count++;
+	tc.metrics.enqueued++;
+	tc.metrics.depth = tc.count;
+	if (tc.count > tc.metrics.max_depth)
+	{
+		tc.metrics.max_depth = tc.count;
+	}
+
+	return true;
+}
+
+bool LoRa::TX_Scheduler::poll()
+{
+	const int8_t selected = select_class();
+
+	if (selected < 0)
+	{
+		return false;
+	}
+
+	send_head(classes[selected]);
+	return true;
+}
+
+void LoRa::TX_Scheduler::flush()
+{
+	while (poll())
+	{
+	}
+}
+
+void LoRa::TX_Scheduler::reset_metrics()
+{
+	for (uint8_t i = 0; i < max_classes; i++)
+	{
+		classes[i].metrics = ClassMetrics{};
+		classes[i].metrics.depth = classes[i].count;
+	}
+}
+
+int8_t LoRa::TX_Scheduler::select_class()
+{
+	bool pending = false;
+
+	for (uint8_t i = 0; i < max_classes; i++)
+	{
+		if (classes[i].count == 0)
+		{
+			continue;
+		}
+		if (classes[i].strict)
+		{
+			return static_cast<int8_t>(i);
+		}
+		pending = true;
+	}
+
+	if (!pending)
+	{
+		return -1;
+	}
+
+	/**
+	 * Deficit round robin. The class under the pointer keeps being served while its
+	 * deficit covers the head frame, then the pointer moves on and the next class is credited.
+	 */
+	while (true)
+	{
+		TrafficClass &tc = classes[round_robin];
+
+		if (!tc.strict && (tc.count > 0))
+		{
+			const Frame &head = tc.frames[tc.head];
+			if (tc.deficit >= head.size)
+			{
+				tc.deficit -= head.size;
+				return static_cast<int8_t>(round_robin);
+			}
+		}
+		else
+		{
+			tc.deficit = 0; /* Idle classes don't save up credit */
+		}
+
+		round_robin = (round_robin + 1) % max_classes;
+
+		TrafficClass &next = classes[round_robin];
+		if (!next.strict && (next.count > 0))
+		{
+			next.deficit += static_cast<uint32_t>(quantum) * next.weight;
+		}
+	}
+}
+
+void LoRa::TX_Scheduler::send_head(TrafficClass &tc)
+{
+	const Frame &frame = tc.frames[tc.head];
+	const int64_t latency = radio.get_device().timestamp_64() - frame.enqueued_at;
+
+	tc.metrics.last_latency = latency;
+	tc.metrics.total_latency += latency;
+	if (latency > tc.metrics.max_latency)
+	{
+		tc.metrics.max_latency = latency;
+	}
+
+	radio.send_packet(frame.data, frame.size);
+
+	tc.head = (tc.head + 1) % queue_depth;
+	tc.count--;
+	tc.metrics.sent++;
+	tc.metrics.depth = tc.count;
+}
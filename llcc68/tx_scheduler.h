@@ -0,0 +1,106 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Priority TX queues in front of the LLCC68 driver.
+ */
+
+#ifndef __LLCC68_TX_SCHEDULER_H__
+#define __LLCC68_TX_SCHEDULER_H__
+
+#include <cstdint>
+
+#include "llcc68.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Queues frames in traffic classes and hands them to the radio one at a time.
+	 * Strict classes are always served first, in index order. Remaining classes share the
+	 * air by deficit round robin according to their weights. An urgent frame therefore waits
+	 * for at most the frame currently on air.
+	 */
+	class TX_Scheduler
+	{
+	public:
+		static constexpr uint8_t max_classes = 4;
+		static constexpr uint8_t queue_depth = 8;
+		static constexpr uint8_t max_frame_size = 255;
+		/* Bytes credited to a weighted class per round, multiplied by its weight */
+		static constexpr uint16_t quantum = 64;
+
+		typedef struct
+		{
+			uint32_t enqueued;
+			uint32_t sent;
+			uint32_t dropped; /* Rejected because the queue was full */
+			uint8_t depth;
+			uint8_t max_depth;
+			int64_t last_latency; /* ms, from enqueue until handed to the radio */
+			int64_t max_latency;
+			int64_t total_latency;
+
+		} ClassMetrics;
+
+		/**
+		 * @brief Class 0 is strict, the others are weighted with weight 1 by default.
+		 */
+		explicit TX_Scheduler(LLCC68 &radio);
+
+		/**
+		 * @param strict Strict classes preempt all weighted classes.
+		 * @param weight Share of a weighted class, ignored for strict classes. Must not be 0.
+		 */
+		bool configure_class(uint8_t traffic_class, bool strict, uint8_t weight);
+
+		/**
+		 * @brief Copies the frame into the queue of the class.
+		 * @return false if the queue is full or parameters are invalid.
+		 */
+		bool enqueue(uint8_t traffic_class, const uint8_t *frame, uint8_t size);
+		/**
+		 * @brief Sends the next frame, if any. Blocks until the radio is done with it.
+		 * @return true if a frame was sent.
+		 */
+		bool poll();
+		/**
+		 * @brief Sends until all queues are empty.
+		 */
+		void flush();
+
+		inline const ClassMetrics &get_metrics(uint8_t traffic_class) const { return classes[traffic_class % max_classes].metrics; }
+		void reset_metrics();
+
+	private:
+		typedef struct
+		{
+			uint8_t data[max_frame_size];
+			uint8_t size;
+			int64_t enqueued_at;
+
+		} Frame;
+
+		typedef struct
+		{
+			Frame frames[queue_depth];
+			uint8_t head;
+			uint8_t count;
+			bool strict;
+			uint8_t weight;
+			uint32_t deficit;
+			ClassMetrics metrics;
+
+		} TrafficClass;
+
+		/* Class to serve next, -1 if all queues are empty */
+		int8_t select_class();
+		void send_head(TrafficClass &traffic_class);
+
+		LLCC68 &radio;
+		TrafficClass classes[max_classes];
+		uint8_t round_robin; /* Next weighted class to visit */
+	};
+}
+
+#endif // __LLCC68_TX_SCHEDULER_H__
@@ -0,0 +1,152 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * AES-128 throughput of the portable and hardware backends (AES-NI or ARMv8, whichever this build and CPU have),
+ * as bulk block encryption in MB/s and as Secure_Frame sealing work (CTR + CMAC) in frames per second.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "..\llcc68\aes.h"
+#include "..\llcc68\secure_frame.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr double run_s = 0.5;
+	constexpr size_t buffer_blocks = 256;
+	constexpr uint8_t key[AES128::key_size] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+											   0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+	const char *backend_name(AES128::Backend backend)
+	{
+		switch (backend)
+		{
+		case AES128::Backend::AES_NI:
+			return "AES-NI";
+		case AES128::Backend::ARMV8:
+			return "ARMv8";
+		default:
+			return "portable";
+		}
+	}
+
+	/* Calls work until run_s has passed, returns calls per second */
+	template <typename F>
+	double rate(F &&work)
+	{
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point start = Clock::now();
+		uint64_t n = 0;
+		double elapsed;
+
+		do
+		{
+			for (uint32_t i = 0; i < 64; i++)
+			{
+				work();
+			}
+			n += 64;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		} while (elapsed < run_s);
+
+		return n / elapsed;
+	}
+
+	/* What Secure_Frame::send does per frame: CTR over the payload in batches of 4 blocks, then CMAC over header and ciphertext */
+	void seal(const AES128 &enc, const AES128_CMAC &cmac, uint32_t counter, uint8_t *frame, uint8_t size)
+	{
+		uint8_t *payload = frame + Secure_Frame::header_size;
+		uint8_t blocks[4 * AES128::block_size];
+		uint8_t mic[AES128::block_size];
+		uint8_t block_index = 0;
+
+		std::memcpy(frame + 2, &counter, sizeof(counter));
+
+		for (uint8_t done = 0; done < size;)
+		{
+			const uint8_t left = static_cast<uint8_t>(size - done);
+			const uint8_t n_blocks = static_cast<uint8_t>((left + AES128::block_size - 1) / AES128::block_size);
+			const uint8_t n = (n_blocks < 4) ? n_blocks : 4;
+
+			std::memset(blocks, 0, sizeof(blocks));
+			for (uint8_t b = 0; b < n; b++)
+			{
+				blocks[b * AES128::block_size] = 0x01;
+				std::memcpy(&blocks[b * AES128::block_size + 1], frame, Secure_Frame::header_size);
+				blocks[b * AES128::block_size + 15] = block_index++;
+			}
+			enc.encrypt_blocks(blocks, blocks, n);
+
+			const uint8_t chunk = (left < n * AES128::block_size) ? left : static_cast<uint8_t>(n * AES128::block_size);
+			for (uint8_t i = 0; i < chunk; i++)
+			{
+				payload[done + i] ^= blocks[i];
+			}
+			done = static_cast<uint8_t>(done + chunk);
+		}
+
+		const Segment segments[] = {{frame, Secure_Frame::header_size}, {payload, size}};
+		cmac.compute(segments, 2, mic);
+		std::memcpy(payload + size, mic, Secure_Frame::mic_size);
+	}
+}
+
+int main()
+{
+	const uint8_t sizes[] = {16, 64, Secure_Frame::max_payload_size};
+	const AES128 portable(key, false);
+	const AES128 hardware(key, true);
+	const AES128 *backends[] = {&portable, &hardware};
+	const size_t n_backends = (hardware.get_backend() == AES128::Backend::PORTABLE) ? 1 : 2;
+
+	/* Both backends must agree before their speeds mean anything */
+	alignas(16) uint8_t a[buffer_blocks * AES128::block_size] = {};
+	alignas(16) uint8_t b[buffer_blocks * AES128::block_size] = {};
+	for (size_t i = 0; i < sizeof(a); i++)
+	{
+		a[i] = b[i] = static_cast<uint8_t>(i * 7);
+	}
+	portable.encrypt_blocks(a, a, buffer_blocks);
+	hardware.encrypt_blocks(b, b, buffer_blocks);
+	if (std::memcmp(a, b, sizeof(a)) != 0)
+	{
+		std::printf("%s output differs from portable\n", backend_name(hardware.get_backend()));
+		return 1;
+	}
+
+	if (n_backends == 1)
+	{
+		std::printf("no hardware backend in this build or CPU\n");
+	}
+
+	std::printf("backend         MB/s   frames/s @16B   frames/s @64B   frames/s @%uB\n", Secure_Frame::max_payload_size);
+
+	for (size_t k = 0; k < n_backends; k++)
+	{
+		const AES128 &aes = *backends[k];
+		const AES128_CMAC cmac(aes);
+		const double blocks_per_s = rate([&aes, &a]()
+										 { aes.encrypt_blocks(a, a, buffer_blocks); }) *
+									buffer_blocks;
+
+		std::printf("%-9s %10.1f", backend_name(aes.get_backend()), blocks_per_s * AES128::block_size / 1e6);
+
+		for (const uint8_t size : sizes)
+		{
+			uint8_t frame[255] = {0x34, 0x12};
+			uint32_t counter = 0;
+
+			std::printf("  %14.0f", rate([&aes, &cmac, &counter, &frame, size]()
+										 { seal(aes, cmac, counter++, frame, size); }));
+		}
+		std::printf("\n");
+	}
+
+	return 0;
+}
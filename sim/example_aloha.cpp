@@ -0,0 +1,104 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Pure ALOHA load test: end nodes around one gateway send periodic uplinks at random offsets.
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 10LL * 60 * 1000000;
+	constexpr uint32_t mean_interval_ms = 60000;
+	constexpr uint8_t payload_size = 20;
+	constexpr double radius_m = 2000.0;
+
+	LLCC68_config make_config()
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = 868100000;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {LLCC68_Constants::SF::SF7, LLCC68_Constants::BW::LORA_BW_125,
+										  LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		config.packet_params._lora = {8, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {14, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	void gateway(Sim_Node &node)
+	{
+		uint8_t buffer[255];
+
+		while (node.is_running())
+		{
+			node.get_radio().receive_packet(buffer, sizeof(buffer), 1000);
+		}
+	}
+
+	void end_node(Sim_Node &node)
+	{
+		uint8_t payload[payload_size] = {};
+
+		payload[0] = static_cast<uint8_t>(node.get_id());
+		payload[1] = static_cast<uint8_t>(node.get_id() >> 8);
+
+		/* Uniform jitter around the mean, starts spread over the first interval */
+		node.sleep_us(static_cast<int64_t>(node.random(mean_interval_ms)) * 1000);
+
+		while (node.is_running())
+		{
+			payload[2]++;
+			node.note_message();
+			node.get_radio().send_packet(payload, payload_size);
+			node.sleep_us(static_cast<int64_t>(mean_interval_ms / 2 + node.random(mean_interval_ms)) * 1000);
+		}
+	}
+
+	Sim_Report run_scenario(uint16_t n_nodes)
+	{
+		const LLCC68_config config = make_config();
+		Simulator simulator;
+
+		simulator.add_node(0.0, 0.0, config, gateway, 0, true);
+
+		for (uint16_t i = 0; i < n_nodes; i++)
+		{
+			/* Golden angle spiral, even coverage of the disc */
+			const double r = radius_m * std::sqrt((i + 0.5) / n_nodes);
+			const double a = 2.399963229728653 * i;
+
+			simulator.add_node(r * std::cos(a), r * std::sin(a), config, end_node);
+		}
+
+		return simulator.run(duration_us);
+	}
+}
+
+int main()
+{
+	const uint16_t loads[] = {50, 100, 200, 500};
+
+	std::printf("nodes    sent  delivered    PDR  collisions  latency(ms)  max(ms)  airtime\n");
+
+	for (const uint16_t n : loads)
+	{
+		const Sim_Report report = run_scenario(n);
+
+		std::printf("%5u  %6u  %9u  %5.3f  %10u  %11.1f  %7.1f  %6.3f\n", n, report.transmissions, report.delivered,
+					report.delivery_ratio, report.collisions, report.mean_latency_us / 1000.0,
+					static_cast<double>(report.max_latency_us) / 1000.0, report.airtime_utilisation);
+	}
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * A gateway scanning four SF/channel pairs with CAD_Scanner while six SF7 and two SF9 nodes send on one of them:
+ * share of the sent frames caught with the adaptive visit order and with a uniform one.
+ */
+
+#include <cstdio>
+
+#include "..\llcc68\cad_scanner.h"
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 5LL * 60 * 1000000;
+	constexpr uint32_t frequency = 868100000;
+	constexpr uint8_t n_sf7_nodes = 6;
+	constexpr uint8_t n_sf9_nodes = 2;
+	constexpr uint8_t n_targets = 4;
+
+	typedef struct
+	{
+		uint32_t sent;
+		CAD_Scanner::Stats stats;
+		uint16_t traffic[n_targets];
+
+	} RunResult;
+
+	LLCC68_config make_config(LLCC68_Constants::SF sf)
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = frequency;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {sf, LLCC68_Constants::BW::LORA_BW_125,
+										  LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		/* Long preamble so a frame outlasts a scan cycle */
+		config.packet_params._lora = {16, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {14, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	RunResult run(bool adaptive)
+	{
+		Simulator simulator;
+		RunResult result{};
+
+		simulator.add_node(0.0, 0.0, make_config(LLCC68_Constants::SF::SF7), [&result, adaptive](Sim_Node &node)
+						   {
+							   CAD_Scanner scanner(node.get_radio());
+							   uint8_t buffer[255];
+
+							   scanner.set_adaptive(adaptive);
+							   scanner.add_target(frequency, LLCC68_Constants::SF::SF7);
+							   scanner.add_target(frequency, LLCC68_Constants::SF::SF8);
+							   scanner.add_target(frequency, LLCC68_Constants::SF::SF9);
+							   scanner.add_target(frequency + 200000, LLCC68_Constants::SF::SF7);
+
+							   while (node.is_running())
+							   {
+								   scanner.receive(buffer, sizeof(buffer), 1000);
+							   }
+							   result.stats = scanner.get_stats();
+							   for (uint8_t i = 0; i < n_targets; i++)
+							   {
+								   result.traffic[i] = scanner.get_traffic(i);
+							   } },
+						   0, true);
+
+		for (uint8_t i = 0; i < n_sf7_nodes + n_sf9_nodes; i++)
+		{
+			const LLCC68_Constants::SF sf = (i < n_sf7_nodes) ? LLCC68_Constants::SF::SF7 : LLCC68_Constants::SF::SF9;
+
+			simulator.add_node(500.0 + 100.0 * i, 200.0, make_config(sf), [&result](Sim_Node &node)
+							   {
+								   uint8_t packet[20] = {};
+
+								   node.sleep_us(node.random(5000000));
+								   while (node.is_running())
+								   {
+									   node.get_radio().send_packet(packet, sizeof(packet));
+									   result.sent++;
+									   node.sleep_us(3000000 + node.random(4000000));
+								   } });
+		}
+
+		simulator.run(duration_us);
+
+		return result;
+	}
+}
+
+int main()
+{
+	std::printf("order     sent  caught  ratio   CADs  false  SF7  SF8  SF9  SF7@868.3  traffic(q8)\n");
+
+	for (const bool adaptive : {true, false})
+	{
+		const RunResult result = run(adaptive);
+		const CAD_Scanner::Stats &stats = result.stats;
+
+		std::printf("%-8s %5u  %6u  %5.2f  %5u  %5u  %3u  %3u  %3u  %9u  %u/%u/%u/%u\n", adaptive ? "adaptive" : "uniform",
+					result.sent, stats.frames, (result.sent > 0) ? static_cast<double>(stats.frames) / result.sent : 0.0,
+					stats.cads, stats.false_detections, stats.frames_per_target[0], stats.frames_per_target[1],
+					stats.frames_per_target[2], stats.frames_per_target[3], result.traffic[0], result.traffic[1],
+					result.traffic[2], result.traffic[3]);
+	}
+
+	return 0;
+}
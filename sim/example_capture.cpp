@@ -0,0 +1,91 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Captures the traffic a gateway hears into capture.pcapng, open it in Wireshark (LoRaTap).
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "..\llcc68\pcap_writer.h"
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 5LL * 60 * 1000000;
+	constexpr uint32_t mean_interval_ms = 10000;
+	constexpr uint16_t n_nodes = 50;
+	constexpr double radius_m = 2000.0;
+
+	LLCC68_config make_config()
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = 868100000;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {LLCC68_Constants::SF::SF7, LLCC68_Constants::BW::LORA_BW_125,
+										  LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		config.packet_params._lora = {8, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {14, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	void end_node(Sim_Node &node)
+	{
+		uint8_t payload[16] = {};
+
+		payload[0] = static_cast<uint8_t>(node.get_id());
+		node.sleep_us(static_cast<int64_t>(node.random(mean_interval_ms)) * 1000);
+
+		while (node.is_running())
+		{
+			payload[1]++;
+			node.note_message();
+			node.get_radio().send_packet(payload, sizeof(payload));
+			node.sleep_us(static_cast<int64_t>(mean_interval_ms / 2 + node.random(mean_interval_ms)) * 1000);
+		}
+	}
+}
+
+int main()
+{
+	std::ofstream file("capture.pcapng", std::ios::binary);
+	Pcap_Writer writer(file);
+	const LLCC68_config config = make_config();
+	Simulator simulator;
+
+	simulator.add_node(0.0, 0.0, config, [&writer](Sim_Node &node)
+					   {
+						   uint8_t buffer[255];
+
+						   node.get_radio().set_capture_sink(&writer);
+						   while (node.is_running())
+						   {
+							   node.get_radio().receive_packet(buffer, sizeof(buffer), 1000);
+						   }
+						   node.get_radio().set_capture_sink(nullptr); },
+					   0, true);
+
+	for (uint16_t i = 0; i < n_nodes; i++)
+	{
+		const double r = radius_m * std::sqrt((i + 0.5) / n_nodes);
+		const double a = 2.399963229728653 * i;
+
+		simulator.add_node(r * std::cos(a), r * std::sin(a), config, end_node);
+	}
+
+	const Sim_Report report = simulator.run(duration_us);
+
+	std::printf("sent %u, delivered %u, captured %llu, dropped %llu\n", report.transmissions, report.delivered,
+				static_cast<unsigned long long>(writer.get_written_count()), static_cast<unsigned long long>(writer.get_dropped_count()));
+
+	return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Payload_Compressor on JSON telemetry and a sensor series: sizes, time on air at SF9, cost per frame
+ * and a random round trip, then a sensor sending through the compressor to a gateway that checks every frame.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "..\llcc68\compressor.h"
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 10LL * 60 * 1000000;
+	constexpr int32_t interval_ms = 10000;
+	constexpr uint32_t n_timing_runs = 20000;
+	constexpr uint32_t n_fuzz_runs = 20000;
+	constexpr uint8_t n_series = 60;
+
+	const char *const samples[] = {
+		"{\"id\":17,\"temp\":21.5,\"humidity\":48,\"battery\":3.71,\"status\":\"ok\"}",
+		"{\"id\":17,\"lat\":41.0123,\"lon\":28.9784,\"rssi\":-97,\"snr\":7.25}",
+		"{\"timestamp\":1760870400,\"voltage\":3.302,\"current\":0.012,\"alarm\":false}"};
+	constexpr uint8_t n_samples = sizeof(samples) / sizeof(samples[0]);
+
+	LLCC68_config make_config()
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = 868100000;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {LLCC68_Constants::SF::SF9, LLCC68_Constants::BW::LORA_BW_125,
+										  LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		config.packet_params._lora = {8, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {14, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	double time_on_air_ms(const LLCC68_config &config, uint8_t size)
+	{
+		const auto &modulation = config.modulation_params._lora;
+		const auto &packet = config.packet_params._lora;
+
+		return LLCC68::calculate_time_on_air(modulation.lora_sf, modulation.bandwidth, modulation.code_rate, modulation.ldro,
+											 packet.preambleLength, packet.headerType, packet.crcType, size) /
+			   1000.0;
+	}
+
+	/* Slowly varying temperature in centi-degrees, wrapping extremes included */
+	void make_series(Sim_Node &node, int32_t *values)
+	{
+		int32_t value = 2150;
+
+		for (uint8_t i = 0; i < n_series; i++)
+		{
+			value += static_cast<int32_t>(node.random(21)) - 10;
+			values[i] = value;
+		}
+		values[5] = INT32_MIN;
+		values[6] = INT32_MAX;
+	}
+
+	/* Runs on a node, time stands still meanwhile so the host clock measures the codec alone */
+	void measure(Sim_Node &node, const LLCC68_config &config)
+	{
+		const Payload_Compressor compressor(node.get_radio());
+		uint8_t frame[255];
+		uint8_t restored[255];
+		uint8_t packed[n_samples][255];
+		uint8_t packed_size[n_samples];
+		uint32_t failures = 0;
+
+		std::printf("sample  bytes  LZ  ToA raw(ms)  ToA LZ(ms)\n");
+		for (uint8_t i = 0; i < n_samples; i++)
+		{
+			const uint8_t size = static_cast<uint8_t>(std::strlen(samples[i]));
+			const uint8_t compressed = compressor.compress(reinterpret_cast<const uint8_t *>(samples[i]), size, packed[i]);
+			/* The format byte travels with either */
+			const uint8_t sent = (compressed > 0) ? compressed : size;
+
+			packed_size[i] = compressed;
+			failures += ((compressed > 0) && ((compressor.decompress(packed[i], compressed, restored, sizeof(restored)) != size) ||
+											  (std::memcmp(restored, samples[i], size) != 0)))
+							? 1
+							: 0;
+
+			std::printf("%6u  %5u  %2u  %11.1f  %10.1f\n", i, size, compressed, time_on_air_ms(config, size + 1), time_on_air_ms(config, sent + 1));
+		}
+
+		int32_t values[n_series];
+		int32_t decoded[n_series];
+		make_series(node, values);
+		const uint8_t series_size = Payload_Compressor::encode_series(values, n_series, frame, Payload_Compressor::max_payload_size);
+		const uint8_t n_decoded = Payload_Compressor::decode_series(frame, series_size, decoded, n_series);
+		failures += ((n_decoded != n_series) || (std::memcmp(values, decoded, sizeof(values)) != 0)) ? 1 : 0;
+		std::printf("series of %u values: %u -> %u bytes\n", n_series, static_cast<unsigned>(sizeof(values)), series_size);
+
+		using Clock = std::chrono::steady_clock;
+		volatile uint32_t sink = 0;
+		const Clock::time_point start = Clock::now();
+		for (uint32_t run = 0; run < n_timing_runs; run++)
+		{
+			const char *sample = samples[run % n_samples];
+			sink = sink + compressor.compress(reinterpret_cast<const uint8_t *>(sample), static_cast<uint8_t>(std::strlen(sample)), frame);
+		}
+		const Clock::time_point compressed = Clock::now();
+		for (uint32_t run = 0; run < n_timing_runs; run++)
+		{
+			const uint8_t i = static_cast<uint8_t>(run % n_samples);
+			sink = sink + compressor.decompress(packed[i], packed_size[i], restored, sizeof(restored));
+		}
+		const Clock::time_point decompressed = Clock::now();
+		std::printf("compress %.2f us/frame, decompress %.2f us/frame\n",
+					std::chrono::duration<double, std::micro>(compressed - start).count() / n_timing_runs,
+					std::chrono::duration<double, std::micro>(decompressed - compressed).count() / n_timing_runs);
+
+		/* Text-like random payloads must round trip, garbage must be rejected without overruns */
+		for (uint32_t run = 0; run < n_fuzz_runs; run++)
+		{
+			uint8_t payload[Payload_Compressor::max_payload_size];
+			const uint8_t size = static_cast<uint8_t>(node.random(Payload_Compressor::max_payload_size + 1));
+			const uint32_t alphabet = 1 + node.random(6);
+
+			for (uint8_t i = 0; i < size; i++)
+			{
+				payload[i] = (node.random(3) == 0) ? static_cast<uint8_t>(samples[0][node.random(20)]) : static_cast<uint8_t>('a' + node.random(alphabet));
+			}
+
+			const uint8_t compressed_size = compressor.compress(payload, size, frame);
+			if (compressed_size > 0)
+			{
+				const uint8_t restored_size = compressor.decompress(frame, compressed_size, restored, sizeof(restored));
+				failures += ((compressed_size >= size) || (restored_size != size) || (std::memcmp(payload, restored, size) != 0)) ? 1 : 0;
+			}
+
+			for (uint8_t i = 0; i < 64; i++)
+			{
+				frame[i] = static_cast<uint8_t>(node.random(256));
+			}
+			compressor.decompress(frame, static_cast<uint8_t>(node.random(64)), restored, static_cast<uint8_t>(node.random(256)));
+		}
+		std::printf("round trip: %u runs, %u failures\n", n_fuzz_runs, failures);
+	}
+}
+
+int main()
+{
+	const LLCC68_config config = make_config();
+	Simulator simulator;
+	uint32_t received = 0;
+	uint32_t mismatches = 0;
+	Payload_Compressor::Stats stats{};
+
+	simulator.add_node(0.0, 0.0, config, [&received, &mismatches](Sim_Node &node)
+					   {
+						   Payload_Compressor compressor(node.get_radio());
+						   uint8_t payload[255];
+						   int32_t values[n_series];
+						   Payload_Compressor::Format format;
+
+						   while (node.is_running())
+						   {
+							   const uint8_t size = compressor.receive(payload, sizeof(payload), 1000, &format);
+							   if (size == 0)
+							   {
+								   continue;
+							   }
+
+							   bool known = (format == Payload_Compressor::Format::SERIES) &&
+											(Payload_Compressor::decode_series(payload, size, values, n_series) == n_series);
+							   for (uint8_t i = 0; (i < n_samples) && !known && (format != Payload_Compressor::Format::SERIES); i++)
+							   {
+								   known = (size == std::strlen(samples[i])) && (std::memcmp(payload, samples[i], size) == 0);
+							   }
+							   received++;
+							   mismatches += known ? 0 : 1;
+						   } },
+					   0, true);
+
+	simulator.add_node(500.0, 0.0, config, [&config, &stats](Sim_Node &node)
+					   {
+						   Payload_Compressor compressor(node.get_radio());
+						   int32_t values[n_series];
+						   uint32_t sent = 0;
+
+						   measure(node, config);
+
+						   while (node.is_running())
+						   {
+							   /* Every fourth frame is a series, the others cycle through the samples */
+							   if ((sent % 4) == 3)
+							   {
+								   make_series(node, values);
+								   compressor.send_series(values, n_series);
+							   }
+							   else
+							   {
+								   const char *sample = samples[sent % n_samples];
+								   compressor.send(reinterpret_cast<const uint8_t *>(sample), static_cast<uint8_t>(std::strlen(sample)));
+							   }
+							   sent++;
+							   node.sleep_us(static_cast<int64_t>(interval_ms) * 1000);
+						   }
+						   stats = compressor.get_stats(); });
+
+	const Sim_Report report = simulator.run(duration_us);
+
+	std::printf("sent %u frames (%u compressed), %llu -> %llu bytes (%.1f%%), received %u, mismatches %u, air time %.2f%%\n",
+				stats.frames, stats.compressed, static_cast<unsigned long long>(stats.bytes_in), static_cast<unsigned long long>(stats.bytes_out),
+				(stats.bytes_in > 0) ? (100.0 * stats.bytes_out / stats.bytes_in) : 0.0, received, mismatches, 100.0 * report.airtime_utilisation);
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Energy per delivered byte of a periodic sensor for each SF and TX power, from the driver's energy ledger.
+ * LLCC68 supports SF5 to SF9 at 125kHz.
+ */
+
+#include <cstdio>
+
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 10LL * 60 * 1000000;
+	constexpr int32_t interval_ms = 10000;
+	constexpr uint8_t payload_size = 20;
+	constexpr double distance_m = 1500.0;
+
+	LLCC68_config make_config(LLCC68_Constants::SF sf, int8_t power_dbm)
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = 868100000;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {sf, LLCC68_Constants::BW::LORA_BW_125, LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		config.packet_params._lora = {8, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {power_dbm, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	void gateway(Sim_Node &node)
+	{
+		uint8_t buffer[255];
+
+		while (node.is_running())
+		{
+			node.get_radio().receive_packet(buffer, sizeof(buffer), 1000);
+		}
+	}
+}
+
+int main()
+{
+	const LLCC68_Constants::SF sfs[] = {LLCC68_Constants::SF::SF7, LLCC68_Constants::SF::SF8, LLCC68_Constants::SF::SF9};
+	const int8_t powers[] = {0, 14, 22};
+
+	std::printf("  SF  dBm  delivered  timed out   TX(ms)     mAh  uAh/byte\n");
+
+	for (const LLCC68_Constants::SF sf : sfs)
+	{
+		for (const int8_t power : powers)
+		{
+			const LLCC68_config config = make_config(sf, power);
+			Simulator simulator;
+			EnergyLedger ledger{};
+			double mah = 0.0;
+			uint32_t timed_out = 0;
+
+			simulator.add_node(0.0, 0.0, config, gateway, 0, true);
+			simulator.add_node(distance_m, 0.0, config, [&ledger, &mah, &timed_out](Sim_Node &node)
+							   {
+								   uint8_t payload[payload_size] = {};
+								   LLCC68 &radio = node.get_radio();
+								   const SleepConfig warm{0, LLCC68_Constants::SleepConfig_StartType::WARM_START, 0,
+														  LLCC68_Constants::SleepConfig_Timeout::TIMEOUT_DISABLED};
+
+								   radio.reset_energy_ledger();
+								   while (node.is_running())
+								   {
+									   payload[0]++;
+									   radio.send_packet(payload, payload_size);
+									   /* The device aborted the frame, it never made it on air whole */
+									   timed_out += (radio.get_last_error() == ErrorCode::TIMED_OUT) ? 1 : 0;
+									   radio.sleep(warm);
+									   node.sleep_us(static_cast<int64_t>(interval_ms) * 1000);
+								   }
+								   ledger = radio.get_energy_ledger();
+								   mah = radio.get_consumed_mah(); });
+
+			const Sim_Report report = simulator.run(duration_us);
+			const double bytes = static_cast<double>(report.delivered) * payload_size;
+
+			std::printf("%4u  %3d  %9u  %9u  %7.1f  %6.4f  %8.5f\n", static_cast<unsigned>(sf), power, report.delivered, timed_out,
+						static_cast<double>(ledger.residency_us[static_cast<uint8_t>(RadioState::TX)]) / 1000.0, mah,
+						(bytes > 0.0) ? (mah * 1000.0 / bytes) : 0.0);
+		}
+	}
+
+	return 0;
+}
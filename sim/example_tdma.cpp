@@ -0,0 +1,135 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * A TDMA coordinator and three nodes: beacons heard and missed once synchronised, the guard time
+ * the nodes settle on and the slot traffic a gateway receives.
+ */
+
+#include <cstdio>
+
+#include "..\llcc68\tdma.h"
+#include "simulator.h"
+
+using namespace LoRa;
+
+namespace
+{
+	constexpr int64_t duration_us = 60LL * 1000000;
+	constexpr uint32_t slot_us = 100000;
+	constexpr uint8_t n_slots = 4;
+	constexpr uint8_t n_nodes = n_slots - 1;
+
+	typedef struct
+	{
+		uint32_t synchronized_beacons; /* Heard in the short window */
+		uint32_t missed_beacons;	   /* Window opened while synchronised, nothing heard */
+		uint32_t long_listens;		   /* Listens while not synchronised */
+		uint32_t sent;
+		uint32_t guard_us;
+		uint32_t jitter_us;
+
+	} NodeResult;
+
+	LLCC68_config make_config()
+	{
+		LLCC68_config config{};
+
+		config.rf_freq = 868100000;
+		config.packet_type = LLCC68_Constants::PacketType::LORA;
+		config.modulation_params._lora = {LLCC68_Constants::SF::SF7, LLCC68_Constants::BW::LORA_BW_125,
+										  LLCC68_Constants::CR::LORA_CR_4_5, LLCC68_Constants::LDRO::OFF};
+		config.packet_params._lora = {8, LLCC68_Constants::HeaderType::EXPLICIT_HEADER, 255,
+									  LLCC68_Constants::CRC_Type::CRC_ON, LLCC68_Constants::InvertIQ::STANDARD_IQ};
+		config.pa_config = {0x02, 0x03};
+		config.tx_params = {14, LLCC68_Constants::RampTime::SET_RAMP_200U};
+
+		return config;
+	}
+
+	void coordinator(Sim_Node &node)
+	{
+		TDMA_Scheduler tdma(node.get_radio(), slot_us, n_slots, 0);
+		uint8_t beacon[4] = {};
+
+		while (node.is_running())
+		{
+			beacon[0]++;
+			tdma.send_beacon(beacon, sizeof(beacon));
+		}
+	}
+
+	void gateway(Sim_Node &node)
+	{
+		uint8_t buffer[255];
+
+		while (node.is_running())
+		{
+			node.get_radio().receive_packet(buffer, sizeof(buffer), 1000);
+		}
+	}
+}
+
+int main()
+{
+	const LLCC68_config config = make_config();
+	Simulator simulator;
+	NodeResult results[n_nodes] = {};
+
+	simulator.add_node(0.0, 0.0, config, coordinator);
+	simulator.add_node(0.0, 200.0, config, gateway, 0, true);
+
+	for (uint8_t i = 0; i < n_nodes; i++)
+	{
+		NodeResult &result = results[i];
+		const uint8_t slot = static_cast<uint8_t>(i + 1);
+
+		simulator.add_node(300.0 * (i + 1), 0.0, config, [&result, slot](Sim_Node &node)
+						   {
+							   TDMA_Scheduler tdma(node.get_radio(), slot_us, n_slots, slot);
+							   uint8_t buffer[255];
+							   uint8_t packet[12] = {slot};
+
+							   while (node.is_running())
+							   {
+								   const bool synchronized = tdma.is_synchronized();
+								   const uint8_t size = tdma.receive_beacon(buffer, sizeof(buffer), 2000);
+
+								   if (!synchronized)
+								   {
+									   result.long_listens++;
+								   }
+								   else if (size > 0)
+								   {
+									   result.synchronized_beacons++;
+								   }
+								   else
+								   {
+									   result.missed_beacons++;
+								   }
+
+								   if ((size > 0) && tdma.send(packet, sizeof(packet)))
+								   {
+									   packet[1]++;
+									   result.sent++;
+								   }
+							   }
+							   result.guard_us = tdma.get_guard_time();
+							   result.jitter_us = tdma.get_jitter(); });
+	}
+
+	const Sim_Report report = simulator.run(duration_us);
+
+	std::printf("node  slot  beacons  missed  long listens  sent  guard(us)  jitter(us)\n");
+	for (uint8_t i = 0; i < n_nodes; i++)
+	{
+		const NodeResult &result = results[i];
+
+		std::printf("%4u  %4u  %7u  %6u  %12u  %4u  %9u  %10u\n", i, i + 1, result.synchronized_beacons, result.missed_beacons,
+					result.long_listens, result.sent, result.guard_us, result.jitter_us);
+	}
+	std::printf("gateway: %u of %u transmissions delivered, %u collisions\n", report.delivered, report.transmissions, report.collisions);
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "medium.h"
+
+#include <algorithm>
+#include <cmath>
+
+using LoRa::Virtual_Medium;
+
+namespace
+{
+	double to_mw(double dbm)
+	{
+		return std::pow(10.0, dbm / 10.0);
+	}
+
+	double to_dbm(double mw)
+	{
+		return 10.0 * std::log10(mw);
+	}
+
+	uint64_t splitmix64(uint64_t x)
+	{
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	uint32_t bandwidth_hz(uint8_t bw)
+	{
+		/* Register values, see LLCC68_Constants::BW */
+		return (bw == 0x06) ? 500000 : ((bw == 0x05) ? 250000 : 125000);
+	}
+}
+
+Virtual_Medium::Virtual_Medium(const Sim_Channel_Model &model)
+	: model{model}, positions{}, sinks{}, has_sinks{false}, transmissions{}, longest_us{0}, collisions{0}, receptions{0}
+{
+}
+
+uint16_t LoRa::Virtual_Medium::add_node(double x, double y, bool sink)
+{
+	positions.push_back(Position{x, y});
+	sinks.push_back(sink);
+	has_sinks = has_sinks || sink;
+
+	return static_cast<uint16_t>(positions.size() - 1);
+}
+
+uint32_t LoRa::Virtual_Medium::transmit(const Sim_Transmission &transmission)
+{
+	transmissions.push_back(transmission);
+	longest_us = std::max(longest_us, transmission.end_us - transmission.start_us);
+
+	return static_cast<uint32_t>(transmissions.size() - 1);
+}
+
+double LoRa::Virtual_Medium::get_path_loss(uint16_t a, uint16_t b) const
+{
+	const double dx = positions[a].x - positions[b].x;
+	const double dy = positions[a].y - positions[b].y;
+	const double distance = std::max(1.0, std::sqrt(dx * dx + dy * dy));
+	double loss = model.reference_loss_db + 10.0 * model.path_loss_exponent * std::log10(distance);
+
+	if (model.shadowing_sigma_db > 0.0)
+	{
+		/* Same value for both directions of a link, Box-Muller on a hash of the pair */
+		const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 16) | std::max(a, b);
+		const uint64_t h1 = splitmix64(key ^ (static_cast<uint64_t>(model.seed) << 32));
+		const uint64_t h2 = splitmix64(h1);
+		const double u1 = (static_cast<double>(h1 >> 11) + 1.0) / 9007199254740993.0;
+		const double u2 = static_cast<double>(h2 >> 11) / 9007199254740992.0;
+
+		loss += model.shadowing_sigma_db * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+	}
+
+	return loss;
+}
+
+double LoRa::Virtual_Medium::get_rx_power(uint32_t index, uint16_t rx_node) const
+{
+	const Sim_Transmission &transmission = transmissions[index];
+
+	return transmission.power_dbm - get_path_loss(transmission.node, rx_node);
+}
+
+double LoRa::Virtual_Medium::get_noise_floor(uint8_t bw) const
+{
+	return -174.0 + 10.0 * std::log10(static_cast<double>(bandwidth_hz(bw))) + model.noise_figure_db;
+}
+
+double LoRa::Virtual_Medium::get_sensitivity(uint8_t sf, uint8_t bw) const
+{
+	/* Demodulator SNR limit drops 2.5dB per SF, -7.5dB at SF7 */
+	return get_noise_floor(bw) - 2.5 * (static_cast<double>(sf) - 4.0);
+}
+
+uint32_t LoRa::Virtual_Medium::first_overlapping(int64_t at_us) const
+{
+	const int64_t earliest = at_us - longest_us;
+	const auto it = std::lower_bound(transmissions.begin(), transmissions.end(), earliest,
+									 [](const Sim_Transmission &t, int64_t value)
+									 { return t.start_us < value; });
+
+	return static_cast<uint32_t>(it - transmissions.begin());
+}
+
+int32_t LoRa::Virtual_Medium::find_preamble(uint16_t rx_node, uint32_t rf_freq, uint8_t sf, uint8_t bw, int64_t from_us, int64_t until_us) const
+{
+	const double sensitivity = get_sensitivity(sf, bw);
+
+	for (uint32_t i = first_overlapping(from_us); i < transmissions.size(); i++)
+	{
+		const Sim_Transmission &t = transmissions[i];
+
+		if (t.start_us > until_us)
+		{
+			break;
+		}
+		/* The modem needs about 5 preamble symbols to detect it */
+		const int64_t latest_us = t.start_us + static_cast<int64_t>(t.preamble_us) - 5 * static_cast<int64_t>(t.symbol_us);
+		if ((t.start_us < from_us) && (latest_us < from_us))
+		{
+			continue;
+		}
+		if ((t.node != rx_node) && (t.rf_freq == rf_freq) && (t.sf == sf) && (t.bw == bw) && (get_rx_power(i, rx_node) >= sensitivity))
+		{
+			return static_cast<int32_t>(i);
+		}
+	}
+
+	return -1;
+}
+
+bool LoRa::Virtual_Medium::resolve(uint32_t index, uint16_t rx_node, int64_t now_us, double *rssi, double *snr)
+{
+	Sim_Transmission &t = transmissions[index];
+	const double signal = get_rx_power(index, rx_node);
+	const double noise = to_mw(get_noise_floor(t.bw));
+	double interference = 0.0;
+
+	for (uint32_t i = first_overlapping(t.start_us); (i < transmissions.size()) && (transmissions[i].start_us < t.end_us); i++)
+	{
+		const Sim_Transmission &other = transmissions[i];
+
+		if ((i == index) || (other.end_us <= t.start_us) || (other.rf_freq != t.rf_freq) || (other.node == rx_node))
+		{
+			continue;
+		}
+
+		double power = get_rx_power(i, rx_node);
+		if ((other.sf != t.sf) || (other.bw != t.bw))
+		{
+			power -= model.inter_sf_rejection_db;
+		}
+		interference += to_mw(power);
+	}
+
+	*rssi = signal;
+	*snr = signal - to_dbm(noise + interference);
+
+	if (t.truncated)
+	{
+		return false;
+	}
+
+	const bool captured = (interference == 0.0) || ((signal - to_dbm(interference)) >= model.capture_threshold_db);
+	const bool above_noise = (signal >= get_sensitivity(t.sf, t.bw));
+	const bool counted = !has_sinks || sinks[rx_node];
+
+	if (!captured || !above_noise)
+	{
+		collisions += counted ? 1 : 0;
+		return false;
+	}
+
+	if (counted)
+	{
+		receptions++;
+		if (t.receptions++ == 0)
+		{
+			t.first_delivery_us = now_us;
+		}
+	}
+
+	return true;
+}
+
+bool LoRa::Virtual_Medium::is_active(uint16_t rx_node, uint32_t rf_freq, uint8_t sf, uint8_t bw, int64_t from_us, int64_t until_us) const
+{
+	const double sensitivity = get_sensitivity(sf, bw);
+
+	for (uint32_t i = first_overlapping(from_us); (i < transmissions.size()) && (transmissions[i].start_us < until_us); i++)
+	{
+		const Sim_Transmission &t = transmissions[i];
+
+		if ((t.end_us > from_us) && (t.node != rx_node) && (t.rf_freq == rf_freq) && (t.sf == sf) && (t.bw == bw) &&
+			(get_rx_power(i, rx_node) >= sensitivity))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+double LoRa::Virtual_Medium::get_channel_power(uint16_t rx_node, uint32_t rf_freq, uint8_t bw, int64_t at_us) const
+{
+	double power = to_mw(get_noise_floor(bw));
+
+	for (uint32_t i = first_overlapping(at_us); (i < transmissions.size()) && (transmissions[i].start_us <= at_us); i++)
+	{
+		const Sim_Transmission &t = transmissions[i];
+
+		if ((t.end_us > at_us) && (t.node != rx_node) && (t.rf_freq == rf_freq))
+		{
+			power += to_mw(get_rx_power(i, rx_node));
+		}
+	}
+
+	return to_dbm(power);
+}
@@ -0,0 +1,125 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Shared radio medium of the simulator. Host only, storage grows with the scenario.
+ */
+
+#ifndef __SIM_MEDIUM_H__
+#define __SIM_MEDIUM_H__
+
+#include <cstdint>
+#include <vector>
+
+namespace LoRa
+{
+	typedef struct
+	{
+		double reference_loss_db;	  /* Path loss at 1m, about 31.2dB at 868MHz */
+		double path_loss_exponent;	  /* 2.0 in free space, 2.7 to 3.5 in urban areas */
+		double shadowing_sigma_db;	  /* Log-normal shadowing, fixed per link. 0 disables it. */
+		double noise_figure_db;		  /* Receiver noise figure */
+		double capture_threshold_db;  /* Signal to interference ratio a packet needs to survive a collision */
+		double inter_sf_rejection_db; /* Interferers with another SF are attenuated this much */
+		uint32_t seed;
+
+	} Sim_Channel_Model;
+
+	/* Suburban defaults */
+	constexpr Sim_Channel_Model default_channel_model{31.2, 2.9, 0.0, 6.0, 6.0, 16.0, 1};
+
+	typedef struct
+	{
+		uint16_t node;
+		uint32_t rf_freq; /* Register value, see LLCC68::calculate_rf_frequency */
+		uint8_t sf;		  /* Register values of SF and BW */
+		uint8_t bw;
+		int8_t power_dbm;
+		uint32_t symbol_us;
+		uint32_t preamble_us; /* Preamble and sync word */
+		uint32_t sync_us;	  /* From start until the header is received */
+		int64_t created_us; /* When the message was handed to the radio, for latency */
+		int64_t start_us;
+		int64_t end_us;
+		uint8_t size;
+		uint8_t payload[255];
+		bool truncated;		 /* Cut short by the SET_TX timeout, never decoded */
+		uint16_t receptions; /* Receivers that got it without error, see add_node */
+		int64_t first_delivery_us;
+
+	} Sim_Transmission;
+
+	/**
+	 * @brief Nodes on a plane sharing the spectrum. Received power follows the log-distance path loss model.
+	 * Receivers lock on the first detectable preamble, which is lost if co-channel interference during the
+	 * packet comes within the capture threshold. Different spreading factors are orthogonal up to the
+	 * inter-SF rejection.
+	 */
+	class Virtual_Medium
+	{
+	public:
+		explicit Virtual_Medium(const Sim_Channel_Model &model = default_channel_model);
+
+		/**
+		 * @param x, y Position in meters.
+		 * @param sink Once any node is a sink, only receptions by sinks count as deliveries.
+		 */
+		uint16_t add_node(double x, double y, bool sink = false);
+		inline uint16_t get_node_count() const { return static_cast<uint16_t>(positions.size()); }
+
+		/* Transmissions must be added in start order. @return Index of the transmission. */
+		uint32_t transmit(const Sim_Transmission &transmission);
+		inline const Sim_Transmission &get_transmission(uint32_t index) const { return transmissions[index]; }
+		inline uint32_t get_transmission_count() const { return static_cast<uint32_t>(transmissions.size()); }
+
+		double get_rx_power(uint32_t index, uint16_t rx_node) const;
+		/* Thermal noise plus noise figure */
+		double get_noise_floor(uint8_t bw) const;
+		/* Noise floor plus the SNR limit of the SF */
+		double get_sensitivity(uint8_t sf, uint8_t bw) const;
+
+		/**
+		 * @brief First transmission on the channel that starts within [from_us, until_us] and is strong enough to be detected.
+		 * One that started earlier still counts while enough of its preamble is left to detect it.
+		 * @return Index, -1 if there is none.
+		 */
+		int32_t find_preamble(uint16_t rx_node, uint32_t rf_freq, uint8_t sf, uint8_t bw, int64_t from_us, int64_t until_us) const;
+		/**
+		 * @brief Decides whether a locked transmission is received without error and records the delivery.
+		 * @param rssi, snr Set to the packet levels, dBm and dB.
+		 */
+		bool resolve(uint32_t index, uint16_t rx_node, int64_t now_us, double *rssi, double *snr);
+		/* Any detectable transmission on the channel overlapping [from_us, until_us], for CAD */
+		bool is_active(uint16_t rx_node, uint32_t rf_freq, uint8_t sf, uint8_t bw, int64_t from_us, int64_t until_us) const;
+		/* Total received power on the frequency at the given time, any modulation */
+		double get_channel_power(uint16_t rx_node, uint32_t rf_freq, uint8_t bw, int64_t at_us) const;
+
+		/* Both count sinks only, see add_node */
+		inline uint32_t get_collision_count() const { return collisions; }
+		inline uint32_t get_reception_count() const { return receptions; }
+
+	private:
+		typedef struct
+		{
+			double x;
+			double y;
+
+		} Position;
+
+		double get_path_loss(uint16_t a, uint16_t b) const;
+		/* First transmission that may still be on air at the given time */
+		uint32_t first_overlapping(int64_t at_us) const;
+
+		Sim_Channel_Model model;
+		std::vector<Position> positions;
+		std::vector<bool> sinks;
+		bool has_sinks;
+		std::vector<Sim_Transmission> transmissions;
+		int64_t longest_us; /* Longest transmission so far, bounds overlap searches */
+		uint32_t collisions;
+		uint32_t receptions;
+	};
+}
+
+#endif // __SIM_MEDIUM_H__
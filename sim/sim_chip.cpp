@@ -0,0 +1,496 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "sim_chip.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "..\llcc68\llcc68.h"
+
+using LoRa::Sim_Chip;
+using LoRa::LLCC68_Constants;
+
+namespace
+{
+	uint8_t to_rssi_register(double dbm)
+	{
+		/* Registers hold -2 * dBm */
+		const double value = -2.0 * dbm;
+		return static_cast<uint8_t>((value < 0.0) ? 0.0 : ((value > 255.0) ? 255.0 : value));
+	}
+}
+
+Sim_Chip::Sim_Chip(Virtual_Medium &medium, uint16_t node, const int64_t &clock, const LLCC68_pins &pins)
+	: medium{medium}, node{node}, clock{clock}, pins{pins}
+{
+	reset_state();
+}
+
+void LoRa::Sim_Chip::reset_state()
+{
+	mode = Mode::STDBY;
+	command_size = 0;
+	std::memset(buffer, 0, sizeof(buffer));
+	std::memset(registers, 0, sizeof(registers));
+	tx_base = 0;
+	rx_base = 0;
+	irq = 0;
+	irq_mask = 0;
+	dio1_mask = 0;
+
+	packet_type = static_cast<uint8_t>(LLCC68_Constants::PacketType::GFSK);
+	rf_freq = 0;
+	power_dbm = 0;
+	sf = 7;
+	bw = static_cast<uint8_t>(LLCC68_Constants::BW::LORA_BW_125);
+	cr = static_cast<uint8_t>(LLCC68_Constants::CR::LORA_CR_4_5);
+	ldro = 0;
+	preamble_length = 8;
+	header_type = static_cast<uint8_t>(LLCC68_Constants::HeaderType::EXPLICIT_HEADER);
+	payload_length = 0;
+	crc_type = static_cast<uint8_t>(LLCC68_Constants::CRC_Type::CRC_ON);
+	cad_symbols = static_cast<uint8_t>(LLCC68_Constants::CadSymbolNum::CAD_ON_2_SYMB);
+	cad_exit_mode = static_cast<uint8_t>(LLCC68_Constants::CadExitMode::CAD_ONLY);
+	cad_timeout = 0;
+	stop_on_preamble = false;
+
+	op_start_us = 0;
+	op_end_us = 0;
+	tx_timed_out = false;
+	rx_deadline_us = -1;
+	rx_continuous = false;
+	listen_from_us = 0;
+	locked = -1;
+	preamble_reported = false;
+	header_reported = false;
+	rx_length = 0;
+	packet_rssi = 0.0;
+	packet_snr = 0.0;
+
+	created_us = -1;
+	tx_count = 0;
+	airtime_us = 0;
+}
+
+uint8_t LoRa::Sim_Chip::get_status() const
+{
+	/* Chip mode in bits 6:4 */
+	switch (mode)
+	{
+	case Mode::TX:
+		return 0x06 << 4;
+	case Mode::RX:
+	case Mode::CAD:
+		return 0x05 << 4;
+	case Mode::SLEEP:
+		return 0;
+	default:
+		return 0x02 << 4;
+	}
+}
+
+void LoRa::Sim_Chip::raise(LLCC68_Constants::ClearIrqParam flag)
+{
+	irq |= static_cast<uint16_t>(flag) & irq_mask;
+}
+
+void LoRa::Sim_Chip::begin_transfer()
+{
+	command_size = 0;
+	update();
+}
+
+uint8_t LoRa::Sim_Chip::exchange(uint8_t value)
+{
+	const uint16_t i = command_size;
+	uint8_t out = get_status();
+
+	if (i < sizeof(command))
+	{
+		command[i] = value;
+	}
+	command_size++;
+
+	if (i == 0)
+	{
+		return out;
+	}
+
+	switch (command[0])
+	{
+	case OPCODE::GET_IRQ_STATUS:
+		out = (i == 2) ? static_cast<uint8_t>(irq >> 8) : ((i == 3) ? static_cast<uint8_t>(irq & 0xFF) : out);
+		break;
+	case OPCODE::GET_RX_BUFFER_STATUS:
+		out = (i == 2) ? rx_length : ((i == 3) ? rx_base : out);
+		break;
+	case OPCODE::READ_BUFFER:
+		if (i >= 3)
+		{
+			out = buffer[static_cast<uint8_t>(command[1] + i - 3)];
+		}
+		break;
+	case OPCODE::READ_REGISTER:
+		if (i >= 4)
+		{
+			out = registers[(((static_cast<uint16_t>(command[1]) << 8) | command[2]) + i - 4) & 0x0FFF];
+		}
+		break;
+	case OPCODE::GET_RSSI_INST:
+		if (i == 2)
+		{
+			out = to_rssi_register(medium.get_channel_power(node, rf_freq, bw, clock));
+		}
+		break;
+	case OPCODE::GET_PACKET_STATUS:
+		if ((i == 2) || (i == 4))
+		{
+			out = to_rssi_register(packet_rssi);
+		}
+		else if (i == 3)
+		{
+			out = static_cast<uint8_t>(static_cast<int8_t>(std::lround(packet_snr * 4.0)));
+		}
+		break;
+	case OPCODE::GET_PACKET_TYPE:
+		if (i == 2)
+		{
+			out = packet_type;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return out;
+}
+
+void LoRa::Sim_Chip::end_transfer()
+{
+	if (command_size > 0)
+	{
+		execute();
+	}
+	command_size = 0;
+}
+
+void LoRa::Sim_Chip::execute()
+{
+	const uint8_t *c = command;
+	const uint16_t n = (command_size < sizeof(command)) ? command_size : sizeof(command);
+
+	switch (c[0])
+	{
+	case OPCODE::SET_STANDBY:
+		mode = Mode::STDBY;
+		locked = -1;
+		break;
+	case OPCODE::SET_SLEEP:
+		mode = Mode::SLEEP;
+		locked = -1;
+		break;
+	case OPCODE::SET_PACKET_TYPE:
+		packet_type = c[1];
+		break;
+	case OPCODE::SET_RF_FREQUENCY:
+		rf_freq = (static_cast<uint32_t>(c[1]) << 24) | (static_cast<uint32_t>(c[2]) << 16) | (static_cast<uint32_t>(c[3]) << 8) | c[4];
+		break;
+	case OPCODE::SET_TX_PARAMS:
+		power_dbm = static_cast<int8_t>(c[1]);
+		break;
+	case OPCODE::SET_MODULATION_PARAMS:
+		if (packet_type == static_cast<uint8_t>(LLCC68_Constants::PacketType::LORA))
+		{
+			sf = c[1];
+			bw = c[2];
+			cr = c[3];
+			ldro = c[4];
+		}
+		break;
+	case OPCODE::SET_PACKET_PARAMS:
+		if (packet_type == static_cast<uint8_t>(LLCC68_Constants::PacketType::LORA))
+		{
+			preamble_length = static_cast<uint16_t>((c[1] << 8) | c[2]);
+			header_type = c[3];
+			payload_length = c[4];
+			crc_type = c[5];
+		}
+		break;
+	case OPCODE::SET_BUFFER_BASE_ADDRESS:
+		tx_base = c[1];
+		rx_base = c[2];
+		break;
+	case OPCODE::WRITE_BUFFER:
+		for (uint16_t k = 2; k < n; k++)
+		{
+			buffer[static_cast<uint8_t>(c[1] + k - 2)] = c[k];
+		}
+		if (created_us < 0)
+		{
+			created_us = clock;
+		}
+		break;
+	case OPCODE::WRITE_REGISTER:
+		for (uint16_t k = 3; k < n; k++)
+		{
+			registers[(((static_cast<uint16_t>(c[1]) << 8) | c[2]) + k - 3) & 0x0FFF] = c[k];
+		}
+		break;
+	case OPCODE::SET_DIO_IRQ_PARAMS:
+		irq_mask = static_cast<uint16_t>((c[1] << 8) | c[2]);
+		dio1_mask = static_cast<uint16_t>((c[3] << 8) | c[4]);
+		break;
+	case OPCODE::CLEAR_IRQ_STATUS:
+		irq &= static_cast<uint16_t>(~((c[1] << 8) | c[2]));
+		break;
+	case OPCODE::STOP_TIMER_ON_PREAMBLE:
+		stop_on_preamble = (c[1] != 0);
+		break;
+	case OPCODE::SET_CAD_PARAMS:
+		cad_symbols = c[1];
+		cad_exit_mode = c[4];
+		cad_timeout = (static_cast<uint32_t>(c[5]) << 16) | (static_cast<uint32_t>(c[6]) << 8) | c[7];
+		break;
+	case OPCODE::SET_TX:
+		start_tx((static_cast<uint32_t>(c[1]) << 16) | (static_cast<uint32_t>(c[2]) << 8) | c[3]);
+		break;
+	case OPCODE::SET_RX:
+		start_rx((static_cast<uint32_t>(c[1]) << 16) | (static_cast<uint32_t>(c[2]) << 8) | c[3]);
+		break;
+	case OPCODE::SET_CAD:
+		mode = Mode::CAD;
+		op_start_us = clock;
+		op_end_us = clock + (static_cast<int64_t>(1) << cad_symbols) *
+								LLCC68::calculate_symbol_time(static_cast<LLCC68_Constants::SF>(sf), static_cast<LLCC68_Constants::BW>(bw));
+		break;
+	default:
+		/* Calibration, regulator, PA and DIO settings don't affect the model */
+		break;
+	}
+}
+
+void LoRa::Sim_Chip::start_tx(uint32_t timeout)
+{
+	if (packet_type != static_cast<uint8_t>(LLCC68_Constants::PacketType::LORA))
+	{
+		raise(LLCC68_Constants::ClearIrqParam::TxDone);
+		mode = Mode::STDBY;
+		return;
+	}
+
+	const auto n_sf = static_cast<LLCC68_Constants::SF>(sf);
+	const auto n_bw = static_cast<LLCC68_Constants::BW>(bw);
+	const uint32_t airtime = LLCC68::calculate_time_on_air(n_sf, n_bw, static_cast<LLCC68_Constants::CR>(cr), static_cast<LLCC68_Constants::LDRO>(ldro),
+														   preamble_length, static_cast<LLCC68_Constants::HeaderType>(header_type),
+														   static_cast<LLCC68_Constants::CRC_Type>(crc_type), payload_length);
+
+	Sim_Transmission transmission{};
+	transmission.node = node;
+	transmission.rf_freq = rf_freq;
+	transmission.sf = sf;
+	transmission.bw = bw;
+	transmission.power_dbm = power_dbm;
+	transmission.symbol_us = LLCC68::calculate_symbol_time(n_sf, n_bw);
+	/* Preamble and sync word take preamble_length + 4.25 symbols, the header 8 more */
+	transmission.preamble_us = ((4 * static_cast<uint32_t>(preamble_length) + 17) * transmission.symbol_us) / 4;
+	transmission.sync_us = transmission.preamble_us + 8 * transmission.symbol_us;
+	transmission.created_us = (created_us >= 0) ? created_us : clock;
+	transmission.start_us = clock;
+	transmission.end_us = clock + airtime;
+	/* 15.625us steps, 0 disables the timeout. The device stops transmitting when it expires. */
+	const int64_t deadline_us = clock + (static_cast<int64_t>(timeout) * 1000) / 64;
+	tx_timed_out = (timeout != 0) && (deadline_us < transmission.end_us);
+	if (tx_timed_out)
+	{
+		transmission.end_us = deadline_us;
+		transmission.truncated = true;
+	}
+	transmission.size = payload_length;
+	for (uint16_t k = 0; k < payload_length; k++)
+	{
+		transmission.payload[k] = buffer[static_cast<uint8_t>(tx_base + k)];
+	}
+
+	medium.transmit(transmission);
+
+	created_us = -1;
+	tx_count++;
+	airtime_us += transmission.end_us - transmission.start_us;
+	mode = Mode::TX;
+	op_start_us = clock;
+	op_end_us = transmission.end_us;
+}
+
+void LoRa::Sim_Chip::start_rx(uint32_t timeout)
+{
+	mode = Mode::RX;
+	rx_continuous = (timeout == 0x00FFFFFF);
+	rx_deadline_us = ((timeout == 0) || rx_continuous) ? -1 : clock + (static_cast<int64_t>(timeout) * 1000) / 64;
+	listen_from_us = clock;
+	locked = -1;
+}
+
+void LoRa::Sim_Chip::update()
+{
+	const int64_t now = clock;
+
+	switch (mode)
+	{
+	case Mode::TX:
+		if (now >= op_end_us)
+		{
+			raise(tx_timed_out ? LLCC68_Constants::ClearIrqParam::Timeout : LLCC68_Constants::ClearIrqParam::TxDone);
+			mode = Mode::STDBY;
+		}
+		break;
+	case Mode::CAD:
+		if (now >= op_end_us)
+		{
+			const bool detected = medium.is_active(node, rf_freq, sf, bw, op_start_us, op_end_us);
+
+			raise(LLCC68_Constants::ClearIrqParam::CadDone);
+			mode = Mode::STDBY;
+			if (detected)
+			{
+				raise(LLCC68_Constants::ClearIrqParam::CadDetected);
+				if (cad_exit_mode == static_cast<uint8_t>(LLCC68_Constants::CadExitMode::CAD_RX))
+				{
+					start_rx(cad_timeout);
+					listen_from_us = op_start_us;
+					update_rx(now);
+				}
+			}
+		}
+		break;
+	case Mode::RX:
+		update_rx(now);
+		break;
+	default:
+		break;
+	}
+}
+
+void LoRa::Sim_Chip::update_rx(int64_t now)
+{
+	while (mode == Mode::RX)
+	{
+		if (locked < 0)
+		{
+			const int32_t candidate = medium.find_preamble(node, rf_freq, sf, bw, listen_from_us, now);
+
+			if (candidate >= 0)
+			{
+				const Sim_Transmission &t = medium.get_transmission(static_cast<uint32_t>(candidate));
+				/* The RX timer stops on preamble or header, depending on STOP_TIMER_ON_PREAMBLE */
+				const int64_t preamble_us = ((t.start_us > listen_from_us) ? t.start_us : listen_from_us) + 5 * static_cast<int64_t>(t.symbol_us);
+				const int64_t detected_us = stop_on_preamble ? preamble_us : t.start_us + t.sync_us;
+
+				if ((rx_deadline_us < 0) || (detected_us <= rx_deadline_us))
+				{
+					locked = candidate;
+					preamble_reported = false;
+					header_reported = false;
+				}
+			}
+
+			if (locked < 0)
+			{
+				if ((rx_deadline_us >= 0) && (now >= rx_deadline_us))
+				{
+					raise(LLCC68_Constants::ClearIrqParam::Timeout);
+					mode = Mode::STDBY;
+				}
+				return;
+			}
+		}
+
+		const Sim_Transmission &t = medium.get_transmission(static_cast<uint32_t>(locked));
+
+		if (!preamble_reported && (now >= ((t.start_us > listen_from_us) ? t.start_us : listen_from_us) + 5 * static_cast<int64_t>(t.symbol_us)))
+		{
+			raise(LLCC68_Constants::ClearIrqParam::PreambleDetected);
+			preamble_reported = true;
+		}
+
+		if (!header_reported && (now >= t.start_us + t.sync_us))
+		{
+			/* Payload shows up in the buffer once the header is valid, early readers see it whole */
+			for (uint16_t k = 0; k < t.size; k++)
+			{
+				buffer[static_cast<uint8_t>(rx_base + k)] = t.payload[k];
+			}
+			rx_length = t.size;
+			raise(LLCC68_Constants::ClearIrqParam::HeaderValid);
+			header_reported = true;
+		}
+
+		if (now < t.end_us)
+		{
+			return;
+		}
+
+		const bool received = medium.resolve(static_cast<uint32_t>(locked), node, t.end_us, &packet_rssi, &packet_snr);
+
+		raise(LLCC68_Constants::ClearIrqParam::RxDone);
+		if (!received)
+		{
+			raise(LLCC68_Constants::ClearIrqParam::CrcErr);
+		}
+
+		locked = -1;
+		if (rx_continuous)
+		{
+			listen_from_us = t.end_us;
+		}
+		else
+		{
+			mode = Mode::STDBY;
+		}
+	}
+}
+
+uint8_t LoRa::Sim_Chip::read_pin(int pin)
+{
+	if (pin == pins.dio1)
+	{
+		update();
+		return ((irq & dio1_mask) != 0) ? IO_HIGH : IO_LOW;
+	}
+
+	/* BUSY and the other DIOs stay low */
+	return IO_LOW;
+}
+
+void LoRa::Sim_Chip::write_pin(int pin, uint8_t value)
+{
+	if ((pin == pins.nreset) && (value == IO_LOW))
+	{
+		const uint32_t sent = tx_count;
+		const int64_t airtime = airtime_us;
+
+		reset_state();
+		tx_count = sent;
+		airtime_us = airtime;
+	}
+}
+
+void LoRa::Sim_SPI::transfer(uint8_t *data, uint8_t size)
+{
+	for (uint8_t i = 0; i < size; i++)
+	{
+		data[i] = chip.exchange(data[i]);
+	}
+}
+
+void LoRa::Sim_SPI::transfer(const uint8_t *data, uint8_t size)
+{
+	for (uint8_t i = 0; i < size; i++)
+	{
+		chip.exchange(data[i]);
+	}
+}
@@ -0,0 +1,149 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Emulated LLCC68 behind the driver's HAL interfaces.
+ */
+
+#ifndef __SIM_CHIP_H__
+#define __SIM_CHIP_H__
+
+#include <cstdint>
+
+#include "..\lora_io.h"
+#include "..\lora_spi.h"
+#include "..\llcc68\opcodes.h"
+#include "medium.h"
+
+namespace LoRa
+{
+	/**
+	 * @brief Decodes the SPI command stream of the driver and plays LoRa packets on the medium.
+	 * Commands take no time and BUSY is never raised. GFSK packets are not modelled: they finish
+	 * right away and never reach the medium.
+	 */
+	class Sim_Chip
+	{
+	public:
+		/**
+		 * @param clock Virtual time in microseconds, read whenever the driver touches the chip.
+		 * @param pins Pin numbers the driver was configured with.
+		 */
+		Sim_Chip(Virtual_Medium &medium, uint16_t node, const int64_t &clock, const LLCC68_pins &pins);
+
+		void begin_transfer();
+		/* Clocks one byte in, returns the byte clocked out */
+		uint8_t exchange(uint8_t value);
+		void end_transfer();
+
+		uint8_t read_pin(int pin);
+		void write_pin(int pin, uint8_t value);
+
+		/* The next packet was created now, latency is counted from here instead of its WRITE_BUFFER */
+		inline void note_message() { created_us = clock; }
+		inline uint16_t get_node() const { return node; }
+		inline uint32_t get_tx_count() const { return tx_count; }
+		inline int64_t get_airtime() const { return airtime_us; }
+
+	private:
+		enum class Mode : uint8_t
+		{
+			SLEEP,
+			STDBY,
+			TX,
+			RX,
+			CAD
+
+		};
+
+		void execute();
+		/* Applies everything that happened on the medium up to now */
+		void update();
+		void update_rx(int64_t now);
+		void start_tx(uint32_t timeout);
+		void start_rx(uint32_t timeout);
+		void raise(LLCC68_Constants::ClearIrqParam flag);
+		void reset_state();
+		uint8_t get_status() const;
+
+		Virtual_Medium &medium;
+		uint16_t node;
+		const int64_t &clock;
+		LLCC68_pins pins;
+
+		Mode mode;
+		uint8_t command[264];
+		uint16_t command_size;
+		uint8_t buffer[256];
+		uint8_t registers[0x1000];
+		uint8_t tx_base;
+		uint8_t rx_base;
+		uint16_t irq;
+		uint16_t irq_mask;
+		uint16_t dio1_mask;
+
+		uint8_t packet_type;
+		uint32_t rf_freq;
+		int8_t power_dbm;
+		uint8_t sf;
+		uint8_t bw;
+		uint8_t cr;
+		uint8_t ldro;
+		uint16_t preamble_length;
+		uint8_t header_type;
+		uint8_t payload_length;
+		uint8_t crc_type;
+		uint8_t cad_symbols;
+		uint8_t cad_exit_mode;
+		uint32_t cad_timeout;
+		bool stop_on_preamble;
+
+		int64_t op_start_us;
+		int64_t op_end_us;	  /* End of TX or CAD */
+		bool tx_timed_out;	  /* TX ends at op_end_us on the SET_TX timeout instead of TxDone */
+		int64_t rx_deadline_us; /* -1 without timeout */
+		bool rx_continuous;
+		int64_t listen_from_us; /* Preambles starting earlier are missed */
+		int32_t locked;			/* Transmission being received, -1 if none */
+		bool preamble_reported;
+		bool header_reported;
+		uint8_t rx_length;
+		double packet_rssi;
+		double packet_snr;
+
+		int64_t created_us; /* -1 if not noted */
+		uint32_t tx_count;
+		int64_t airtime_us;
+	};
+
+	class Sim_SPI : public LoRa_SPI
+	{
+	public:
+		explicit Sim_SPI(Sim_Chip &chip) : LoRa_SPI(0, 0, 0, 0), chip{chip} {}
+
+		virtual void begin_transfer() override { chip.begin_transfer(); }
+		virtual void end_transfer() override { chip.end_transfer(); }
+		virtual uint8_t transfer(uint8_t value) override { return chip.exchange(value); }
+		virtual void transfer(uint8_t *data, uint8_t size) override;
+		virtual void transfer(const uint8_t *data, uint8_t size) override;
+		virtual void set_bit_order(bool msb_first = true) override { bit_order_msb_first = msb_first; }
+
+	private:
+		Sim_Chip &chip;
+	};
+
+	class Sim_IO : public LoRa_IO
+	{
+	public:
+		explicit Sim_IO(Sim_Chip &chip) : chip{chip} {}
+
+		virtual uint8_t read(const int pin) override { return chip.read_pin(pin); }
+		virtual void write(const int pin, const uint8_t value) override { chip.write_pin(pin, value); }
+
+	private:
+		Sim_Chip &chip;
+	};
+}
+
+#endif // __SIM_CHIP_H__
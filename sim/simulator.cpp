@@ -0,0 +1,231 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ */
+
+#include "simulator.h"
+
+#include <algorithm>
+
+#include "..\llcc68\nrf_llcc68.h"
+
+using LoRa::Sim_Node;
+using LoRa::Simulator;
+
+namespace
+{
+	/* Pin numbers only need to be consistent between the driver and the chip */
+	constexpr LoRa::LLCC68_pins sim_pins{0, 1, 2, 3, 4, 5};
+
+	class Sim_Device : public LoRa::Device
+	{
+	public:
+		explicit Sim_Device(Sim_Node &node) : node{node} {}
+
+		virtual void delay(int32_t ms) override { node.sleep_us(static_cast<int64_t>(ms) * 1000); }
+		virtual int32_t timestamp(void) override { return static_cast<int32_t>(node.now_us() / 1000); }
+		virtual int64_t timestamp_64(void) override { return node.now_us() / 1000; }
+		/* Busy loops on the clock must see it move, every read costs 10us */
+		virtual int64_t timestamp_us(void) override
+		{
+			node.sleep_us(10);
+			return node.now_us();
+		}
+
+	private:
+		Sim_Node &node;
+	};
+
+	class Sim_Radio : public LoRa::NRF_LLCC68
+	{
+	public:
+		using LoRa::NRF_LLCC68::NRF_LLCC68;
+		using LoRa::NRF_LLCC68::init_llcc68;
+	};
+}
+
+Sim_Node::Sim_Node(Simulator &simulator, uint16_t id, const LLCC68_config &config, std::function<void(Sim_Node &)> behaviour, uint32_t seed)
+	: simulator{simulator}, chip{simulator.medium, id, simulator.now, sim_pins}, radio{}, config{config}, behaviour{std::move(behaviour)},
+	  random_state{(seed * 0x9E3779B9u) ^ ((static_cast<uint32_t>(id) + 1) * 0x85EBCA6Bu)}, runnable{false}, finished{false}, wake{}, thread{}
+{
+	if (random_state == 0)
+	{
+		random_state = 1;
+	}
+}
+
+bool LoRa::Sim_Node::is_running() const
+{
+	return simulator.now < simulator.end_us;
+}
+
+int64_t LoRa::Sim_Node::now_us() const
+{
+	return simulator.now;
+}
+
+void LoRa::Sim_Node::sleep_us(int64_t us)
+{
+	sleep_until(simulator.now + ((us > 0) ? us : 0));
+}
+
+uint32_t LoRa::Sim_Node::random(uint32_t bound)
+{
+	/* xorshift32 */
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+
+	return (bound == 0) ? 0 : static_cast<uint32_t>((static_cast<uint64_t>(random_state) * bound) >> 32);
+}
+
+void LoRa::Sim_Node::sleep_until(int64_t us)
+{
+	std::unique_lock<std::mutex> guard{simulator.lock};
+
+	simulator.events.push(Simulator::Event{us, get_id()});
+	runnable = false;
+	simulator.idle.notify_one();
+	wake.wait(guard, [this]
+			  { return runnable; });
+}
+
+void LoRa::Sim_Node::main()
+{
+	{
+		std::unique_lock<std::mutex> guard{simulator.lock};
+		wake.wait(guard, [this]
+				  { return runnable; });
+	}
+
+	auto sim_radio = std::make_unique<Sim_Radio>(sim_pins, config, std::make_unique<Sim_SPI>(chip), std::make_unique<Sim_IO>(chip),
+												 std::make_unique<Sim_Device>(*this));
+	sim_radio->reset();
+	sim_radio->init_llcc68();
+	radio = std::move(sim_radio);
+
+	behaviour(*this);
+
+	std::lock_guard<std::mutex> guard{simulator.lock};
+	finished = true;
+	runnable = false;
+	simulator.idle.notify_one();
+}
+
+Simulator::Simulator(const Sim_Channel_Model &model)
+	: model{model}, medium{model}, nodes{}, events{}, now{0}, end_us{0}, lock{}, idle{}
+{
+}
+
+Simulator::~Simulator()
+{
+	for (auto &node : nodes)
+	{
+		if (node->thread.joinable())
+		{
+			node->thread.join();
+		}
+	}
+}
+
+uint16_t LoRa::Simulator::add_node(double x, double y, const LLCC68_config &config, std::function<void(Sim_Node &)> behaviour,
+								   int64_t start_us, bool sink)
+{
+	const uint16_t id = medium.add_node(x, y, sink);
+
+	nodes.push_back(std::unique_ptr<Sim_Node>(new Sim_Node(*this, id, config, std::move(behaviour), model.seed)));
+	events.push(Event{start_us, id});
+
+	return id;
+}
+
+LoRa::Sim_Report LoRa::Simulator::run(int64_t duration_us)
+{
+	end_us = duration_us;
+
+	for (auto &node : nodes)
+	{
+		node->thread = std::thread(&Sim_Node::main, node.get());
+	}
+
+	std::unique_lock<std::mutex> guard{lock};
+
+	/* Hand the token to the earliest node and wait until it sleeps or returns */
+	while (!events.empty())
+	{
+		const Event event = events.top();
+		events.pop();
+
+		Sim_Node &node = *nodes[event.node];
+		now = std::max(now, event.wake_us);
+		node.runnable = true;
+		node.wake.notify_one();
+		idle.wait(guard, [&node]
+				  { return !node.runnable; });
+	}
+
+	guard.unlock();
+
+	for (auto &node : nodes)
+	{
+		node->thread.join();
+	}
+
+	return make_report();
+}
+
+LoRa::Sim_Report LoRa::Simulator::make_report() const
+{
+	Sim_Report report{};
+	std::vector<uint32_t> channels;
+	int64_t airtime = 0;
+	int64_t latency = 0;
+
+	report.duration_us = end_us;
+
+	for (uint32_t i = 0; i < medium.get_transmission_count(); i++)
+	{
+		const Sim_Transmission &t = medium.get_transmission(i);
+
+		if (t.start_us >= end_us)
+		{
+			break;
+		}
+
+		report.transmissions++;
+		airtime += std::min(t.end_us, end_us) - t.start_us;
+		if (std::find(channels.begin(), channels.end(), t.rf_freq) == channels.end())
+		{
+			channels.push_back(t.rf_freq);
+		}
+
+		if (t.receptions > 0)
+		{
+			const int64_t delay = t.first_delivery_us - t.created_us;
+
+			report.delivered++;
+			latency += delay;
+			report.max_latency_us = std::max(report.max_latency_us, delay);
+		}
+	}
+
+	report.receptions = medium.get_reception_count();
+	report.collisions = medium.get_collision_count();
+	report.n_channels = static_cast<uint32_t>(channels.size());
+	if (report.transmissions > 0)
+	{
+		report.delivery_ratio = static_cast<double>(report.delivered) / report.transmissions;
+	}
+	if (report.delivered > 0)
+	{
+		report.mean_latency_us = static_cast<double>(latency) / report.delivered;
+	}
+	if ((end_us > 0) && (report.n_channels > 0))
+	{
+		report.airtime_utilisation = static_cast<double>(airtime) / (static_cast<double>(end_us) * report.n_channels);
+	}
+
+	return report;
+}
@@ -0,0 +1,141 @@
+/**
+ * @author SERDAR PEHLIVAN
+ * @date 19/10/2026
+ * @version 1.0
+ *
+ * Discrete event simulator running many driver instances on one virtual medium. Host only.
+ */
+
+#ifndef __SIM_SIMULATOR_H__
+#define __SIM_SIMULATOR_H__
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "..\llcc68\llcc68.h"
+#include "medium.h"
+#include "sim_chip.h"
+
+namespace LoRa
+{
+	class Simulator;
+
+	typedef struct
+	{
+		int64_t duration_us;
+		uint32_t transmissions; /* Started within the duration */
+		uint32_t delivered;		/* Of those, received by at least one sink */
+		uint32_t receptions;	/* Successful receptions, a packet may count more than once */
+		uint32_t collisions;	/* Packets a receiver locked on but lost */
+		double delivery_ratio;
+		double mean_latency_us; /* From creation to the end of the first reception */
+		int64_t max_latency_us;
+		double airtime_utilisation; /* Air time over duration, averaged over the channels in use */
+		uint32_t n_channels;
+
+	} Sim_Report;
+
+	/**
+	 * @brief One simulated device. Its behaviour runs on a thread of its own but only one node
+	 * runs at a time, time stands still until the node sleeps. The driver's delays sleep the node.
+	 */
+	class Sim_Node
+	{
+	public:
+		inline LLCC68 &get_radio() { return *radio; }
+		inline uint16_t get_id() const { return chip.get_node(); }
+		/* false once the simulated duration has elapsed, behaviours should return then */
+		bool is_running() const;
+		int64_t now_us() const;
+		void sleep_us(int64_t us);
+		/* Deterministic per node, in [0, bound) */
+		uint32_t random(uint32_t bound);
+		/* The next packet was created now, see Sim_Chip::note_message */
+		inline void note_message() { chip.note_message(); }
+
+	private:
+		friend class Simulator;
+
+		Sim_Node(Simulator &simulator, uint16_t id, const LLCC68_config &config, std::function<void(Sim_Node &)> behaviour, uint32_t seed);
+
+		void main();
+		void sleep_until(int64_t us);
+
+		Simulator &simulator;
+		Sim_Chip chip;
+		std::unique_ptr<LLCC68> radio;
+		LLCC68_config config;
+		std::function<void(Sim_Node &)> behaviour;
+		uint32_t random_state;
+		bool runnable; /* Holds the token */
+		bool finished;
+		std::condition_variable wake;
+		std::thread thread;
+	};
+
+	class Simulator
+	{
+	public:
+		explicit Simulator(const Sim_Channel_Model &model = default_channel_model);
+		~Simulator();
+
+		Simulator(const Simulator &) = delete;
+		Simulator &operator=(const Simulator &) = delete;
+
+		/**
+		 * @brief Adds a device. The radio is initialized with the config before the behaviour starts.
+		 * @param x, y Position in meters.
+		 * @param start_us When the node powers up.
+		 * @param sink See Virtual_Medium::add_node.
+		 * @return Node id.
+		 */
+		uint16_t add_node(double x, double y, const LLCC68_config &config, std::function<void(Sim_Node &)> behaviour,
+						  int64_t start_us = 0, bool sink = false);
+
+		/**
+		 * @brief Runs the scenario until every behaviour has returned. Call once.
+		 * @param duration_us Nodes see is_running() false from here on, packets started later are not reported.
+		 */
+		Sim_Report run(int64_t duration_us);
+
+		inline const Virtual_Medium &get_medium() const { return medium; }
+		inline const Sim_Node &get_node(uint16_t id) const { return *nodes[id]; }
+
+	private:
+		friend class Sim_Node;
+
+		typedef struct
+		{
+			int64_t wake_us;
+			uint16_t node;
+
+		} Event;
+
+		struct Later
+		{
+			bool operator()(const Event &a, const Event &b) const
+			{
+				return (a.wake_us != b.wake_us) ? (a.wake_us > b.wake_us) : (a.node > b.node);
+			}
+		};
+
+		Sim_Report make_report() const;
+
+		Sim_Channel_Model model;
+		Virtual_Medium medium;
+		std::vector<std::unique_ptr<Sim_Node>> nodes;
+		std::priority_queue<Event, std::vector<Event>, Later> events;
+		int64_t now;	/* Virtual time, read by the chips */
+		int64_t end_us; /* Set by run() */
+		std::mutex lock;
+		std::condition_variable idle; /* A node gave the token back */
+	};
+}
+
+#endif // __SIM_SIMULATOR_H__